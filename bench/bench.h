@@ -0,0 +1,72 @@
+/**
+ * @file bench.h
+ * @brief Minimal timing harness shared by the benchmark programs
+ * @details Each benchmark runs a callable for a fixed number of iterations,
+ *          repeats that a few times and reports the fastest repetition, which
+ *          is the least noisy estimate on a busy machine.
+ */
+
+#ifndef bench_H
+#define bench_H
+
+#include <chrono>
+#include <cstdio>
+#include <algorithm>
+
+/**
+ * @brief Runs @p fn @p iterations times per repetition and prints the best time
+ * @param name Label printed in the results line
+ * @param iterations Calls per repetition
+ * @param items Work items processed per call (used for the per-item figure)
+ * @param fn Callable under test
+ * @return Best nanoseconds per item
+ */
+template <typename Fn>
+double runBenchmark(const char *name, int iterations, long items, Fn fn)
+{
+    const int repetitions = 5;
+    double best_ns = 1e300;
+
+    for (int rep = 0; rep < repetitions; rep++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++)
+        {
+            fn();
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        double ns = std::chrono::duration<double, std::nano>(elapsed).count();
+        best_ns = std::min(best_ns, ns / (double(iterations) * items));
+    }
+
+    printf("%-40s %12.1f ns/item  (%ld items x %d iterations)\n", name, best_ns, items, iterations);
+    return best_ns;
+}
+
+/**
+ * @brief Like runBenchmark(), choosing the iteration count from one timed call
+ * @param target_ms Approximate duration of one repetition
+ * @param iterations_out Receives the iteration count that was used
+ * @return Best nanoseconds per item
+ */
+template <typename Fn>
+double runCalibratedBenchmark(const char *name, long items, Fn fn, int &iterations_out, double target_ms = 100.0)
+{
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    double once_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    iterations_out = (int)std::max(1.0, std::min(1e6, target_ms / std::max(once_ms, 1e-6)));
+    return runBenchmark(name, iterations_out, items, fn);
+}
+
+/**
+ * @brief Prevents the compiler from optimising away a benchmark result
+ */
+template <typename T>
+inline void doNotOptimize(const T &value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+#endif
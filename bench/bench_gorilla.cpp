@@ -0,0 +1,255 @@
+/**
+ * @file bench_gorilla.cpp
+ * @brief Compression ratio and decode speed of CompressedSeries
+ * @details Reports bytes per sample for CPU, thermal and fan traces, and the
+ *          time to decode a full hour at the default 10 Hz sample rate
+ *          (36,000 samples), which is what the "1 hour (every sample)" graph
+ *          window does every frame.
+ *
+ *          Traces come from, in order of preference:
+ *          - a text file given with --trace SERIES FILE ("time_ms value" per
+ *            line), e.g. exported from a long-running monitor
+ *          - a live capture of this machine's sensors for --seconds seconds
+ *            at 10 Hz, read the same way the collectors read them
+ *          - a modelled trace with the same quantisation as the kernel
+ *            interfaces (whole or half degrees, integer RPM), used for any
+ *            sensor this machine does not have and to fill out the hour
+ *
+ * Build and run:
+ *   make bench_gorilla && ./bench_gorilla [--seconds N] [--trace cpu|thermal|fan FILE]
+ */
+
+#include "../collector.h"
+#include "bench.h"
+#include <random>
+
+struct Trace
+{
+    vector<int64_t> times;
+    vector<float> values;
+    string source;
+};
+
+static const int SAMPLE_INTERVAL_MS = 100;
+static const size_t HOUR_SAMPLES = 3600 * 1000 / SAMPLE_INTERVAL_MS;
+
+// =============================================================================
+// TRACE SOURCES
+// =============================================================================
+
+static bool loadTrace(const string &path, Trace &trace)
+{
+    ifstream file(path);
+    int64_t time;
+    float value;
+    while (file >> time >> value)
+    {
+        trace.times.push_back(time);
+        trace.values.push_back(value);
+    }
+    trace.source = path;
+    return !trace.values.empty();
+}
+
+static bool readCpuTotals(long long &busy, long long &total)
+{
+    ifstream file("/proc/stat");
+    string cpu;
+    long long user, nice, system, idle, iowait, irq, softirq, steal;
+    if (!(file >> cpu >> user >> nice >> system >> idle >> iowait >> irq >> softirq >> steal))
+        return false;
+    busy = user + nice + system + irq + softirq + steal;
+    total = busy + idle + iowait;
+    return true;
+}
+
+static bool readThermal(float &celsius)
+{
+    ifstream file("/sys/class/thermal/thermal_zone0/temp");
+    long millidegrees;
+    if (!(file >> millidegrees))
+        return false;
+    celsius = millidegrees / 1000.0f;
+    return true;
+}
+
+static bool readFan(float &rpm)
+{
+    for (int hwmon = 0; hwmon < 16; hwmon++)
+    {
+        ifstream file("/sys/class/hwmon/hwmon" + to_string(hwmon) + "/fan1_input");
+        long value;
+        if (file >> value)
+        {
+            rpm = (float)value;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Samples CPU usage, temperature and fan speed at 10 Hz
+ */
+static void captureLive(int seconds, Trace &cpu, Trace &thermal, Trace &fan)
+{
+    long long prev_busy = 0, prev_total = 0;
+    readCpuTotals(prev_busy, prev_total);
+
+    auto start = chrono::steady_clock::now();
+    auto next = start;
+    for (int i = 0; i < seconds * 1000 / SAMPLE_INTERVAL_MS; i++)
+    {
+        next += chrono::milliseconds(SAMPLE_INTERVAL_MS);
+        this_thread::sleep_until(next);
+        int64_t now_ms = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+
+        long long busy, total;
+        if (readCpuTotals(busy, total) && total > prev_total)
+        {
+            cpu.times.push_back(now_ms);
+            cpu.values.push_back(100.0f * (busy - prev_busy) / (total - prev_total));
+            prev_busy = busy;
+            prev_total = total;
+        }
+
+        float value;
+        if (readThermal(value))
+        {
+            thermal.times.push_back(now_ms);
+            thermal.values.push_back(value);
+        }
+        if (readFan(value))
+        {
+            fan.times.push_back(now_ms);
+            fan.values.push_back(value);
+        }
+    }
+    cpu.source = thermal.source = fan.source = "live capture";
+}
+
+/**
+ * @brief Random walk with the given quantisation step and sample jitter
+ */
+static void modelTrace(Trace &trace, size_t samples, float start, float lo, float hi,
+                       float walk, float step, unsigned seed)
+{
+    mt19937 rng(seed);
+    normal_distribution<float> noise(0.0f, walk);
+    uniform_int_distribution<int> jitter(-3, 3);
+
+    float level = start;
+    int64_t time = 0;
+    for (size_t i = 0; i < samples; i++)
+    {
+        level = max(lo, min(hi, level + noise(rng)));
+        float value = step > 0 ? roundf(level / step) * step : level;
+        trace.times.push_back(time);
+        trace.values.push_back(value);
+        time += SAMPLE_INTERVAL_MS + jitter(rng);
+    }
+    trace.source = "modelled";
+}
+
+// =============================================================================
+// MEASUREMENTS
+// =============================================================================
+
+static CompressedSeries compress(const Trace &trace)
+{
+    CompressedSeries series(chrono::hours(24 * 365));
+    for (size_t i = 0; i < trace.values.size(); i++)
+        series.append(trace.times[i], trace.values[i]);
+    return series;
+}
+
+static void reportRatio(const char *name, const Trace &trace)
+{
+    if (trace.values.empty())
+    {
+        printf("%-8s no samples\n", name);
+        return;
+    }
+
+    CompressedSeries series = compress(trace);
+    vector<float> values;
+    vector<int64_t> times;
+    series.decode(values, &times);
+    bool exact = values.size() == trace.values.size() &&
+                 memcmp(values.data(), trace.values.data(), values.size() * sizeof(float)) == 0 &&
+                 times == trace.times;
+
+    double per_sample = double(series.bytes()) / series.size();
+    printf("%-8s %7zu samples  %6.2f bytes/sample  (%.1fx vs 12-byte time+float, %s)  [%s]\n",
+           name, series.size(), per_sample, 12.0 / per_sample,
+           exact ? "round-trip exact" : "ROUND-TRIP MISMATCH", trace.source.c_str());
+}
+
+int main(int argc, char **argv)
+{
+    int seconds = 30;
+    Trace cpu, thermal, fan;
+
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if (arg == "--seconds" && i + 1 < argc)
+        {
+            seconds = max(1, atoi(argv[++i]));
+        }
+        else if (arg == "--trace" && i + 2 < argc)
+        {
+            string series = argv[++i];
+            string path = argv[++i];
+            Trace &target = series == "cpu" ? cpu : series == "thermal" ? thermal : fan;
+            if (!loadTrace(path, target))
+                fprintf(stderr, "could not read %s\n", path.c_str());
+        }
+    }
+
+    if (cpu.values.empty() || thermal.values.empty() || fan.values.empty())
+    {
+        Trace live_cpu, live_thermal, live_fan;
+        printf("Capturing %d s of live samples at %d Hz...\n", seconds, 1000 / SAMPLE_INTERVAL_MS);
+        captureLive(seconds, live_cpu, live_thermal, live_fan);
+        if (cpu.values.empty())
+            cpu = move(live_cpu);
+        if (thermal.values.empty())
+            thermal = move(live_thermal);
+        if (fan.values.empty())
+            fan = move(live_fan);
+    }
+
+    // Sensors this machine lacks: model their kernel quantisation instead
+    if (thermal.values.empty())
+        modelTrace(thermal, HOUR_SAMPLES, 45.0f, 30.0f, 95.0f, 0.15f, 1.0f, 2);
+    if (fan.values.empty())
+        modelTrace(fan, HOUR_SAMPLES, 2100.0f, 800.0f, 5000.0f, 8.0f, 1.0f, 3);
+
+    printf("\nCompression (Gorilla delta-of-delta timestamps + XOR floats):\n");
+    reportRatio("cpu", cpu);
+    reportRatio("thermal", thermal);
+    reportRatio("fan", fan);
+
+    // Decode cost of a full hour, as the graph pays each frame
+    Trace hour;
+    modelTrace(hour, HOUR_SAMPLES, 20.0f, 0.0f, 100.0f, 2.0f, 0.0f, 1);
+    CompressedSeries hour_series = compress(hour);
+    vector<float> values;
+    values.reserve(HOUR_SAMPLES);
+
+    printf("\nDecoding one hour (%zu samples, %zu bytes):\n", hour_series.size(), hour_series.bytes());
+    double ns = runBenchmark("CompressedSeries::decode", 20, (long)HOUR_SAMPLES, [&]
+                             {
+        hour_series.decode(values);
+        doNotOptimize(values.data()); });
+    printf("%-40s %12.3f ms per 1-hour plot (frame budget at 60 FPS: 16.7 ms)\n", "", ns * HOUR_SAMPLES / 1e6);
+
+    runBenchmark("CompressedSeries::append", 1, (long)HOUR_SAMPLES, [&]
+                 {
+        CompressedSeries series(chrono::hours(1));
+        for (size_t i = 0; i < hour.values.size(); i++)
+            series.append(hour.times[i], hour.values[i]);
+        doNotOptimize(series.bytes()); });
+    return 0;
+}
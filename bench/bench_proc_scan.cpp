@@ -0,0 +1,107 @@
+/**
+ * @file bench_proc_scan.cpp
+ * @brief /proc enumeration and full-scan latency, before and after getdents64
+ * @details Compares the original opendir()/readdir() loop (std::string per
+ *          entry, all_of(::isdigit), stoi) with listProcPids(), first for the
+ *          enumeration alone and then for a complete getAllProcesses() scan,
+ *          and reports how a ProcessScanner scales with 1, 4, 16 and 64 workers.
+ *
+ * Build and run:
+ *   make bench_proc_scan && ./bench_proc_scan
+ */
+
+#include "../collector.h"
+#include "bench.h"
+#include <fcntl.h>
+
+/**
+ * @brief The original enumeration loop from getAllProcesses()/getProcessCounts()
+ */
+static void legacyListPids(vector<int> &pids)
+{
+    pids.clear();
+    DIR *proc_dir = opendir("/proc");
+    if (proc_dir == nullptr)
+        return;
+
+    struct dirent *entry;
+    while ((entry = readdir(proc_dir)) != nullptr)
+    {
+        if (entry->d_type == DT_DIR)
+        {
+            string dir_name = entry->d_name;
+            if (all_of(dir_name.begin(), dir_name.end(), ::isdigit))
+            {
+                pids.push_back(stoi(dir_name));
+            }
+        }
+    }
+    closedir(proc_dir);
+}
+
+/**
+ * @brief Full scan as it was done before: readdir loop + uncached getProcessInfo()
+ */
+static vector<Proc> legacyGetAllProcesses()
+{
+    vector<int> pids;
+    legacyListPids(pids);
+
+    vector<Proc> processes;
+    for (int pid : pids)
+    {
+        Proc proc = getProcessInfo(pid);
+        if (!proc.name.empty())
+            processes.push_back(proc);
+    }
+    return processes;
+}
+
+int main()
+{
+    vector<int> pids;
+    int proc_dirfd = open("/proc", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+    listProcPids(proc_dirfd, pids);
+    vector<int> legacy_pids;
+    legacyListPids(legacy_pids);
+    printf("Benchmarking /proc enumeration over %zu processes (readdir found %zu)\n\n",
+           pids.size(), legacy_pids.size());
+
+    double before = runBenchmark("enumerate: opendir/readdir + stoi", 200, pids.size(), [&]
+                                 {
+        legacyListPids(legacy_pids);
+        doNotOptimize(legacy_pids.data()); });
+
+    double after = runBenchmark("enumerate: getdents64 + from_chars", 200, pids.size(), [&]
+                                {
+        listProcPids(proc_dirfd, pids);
+        doNotOptimize(pids.data()); });
+
+    printf("  enumeration speedup: %.2fx\n\n", before / after);
+
+    double scan_before = runBenchmark("full scan: readdir + open/read/close", 10, pids.size(), []
+                                      { doNotOptimize(legacyGetAllProcesses()); });
+
+    double scan_after = runBenchmark("full scan: getAllProcesses()", 10, pids.size(), []
+                                     { doNotOptimize(getAllProcesses()); });
+
+    printf("  full scan speedup: %.2fx\n\n", scan_before / scan_after);
+
+    printf("Worker scaling (%u hardware threads)\n", thread::hardware_concurrency());
+    double single = 0.0;
+    for (int workers : {1, 4, 16, 64})
+    {
+        ProcessScanner scanner(workers);
+        char name[64];
+        snprintf(name, sizeof(name), "full scan: %d worker(s)", workers);
+        double ns = runBenchmark(name, 10, pids.size(), [&]
+                                 { doNotOptimize(scanner.scan()); });
+        if (workers == 1)
+            single = ns;
+        printf("  scaling vs 1 worker: %.2fx\n", single / ns);
+    }
+
+    close(proc_dirfd);
+    return 0;
+}
@@ -0,0 +1,145 @@
+/**
+ * @file bench_proc_stat.cpp
+ * @brief Per-process cost of reading /proc/[pid]/stat, before and after the
+ *        zero-allocation parser
+ * @details Compares the original iostream/tokenizer implementation of
+ *          getProcessInfo() with the current one over every live PID, and
+ *          times parseProcStat() on an in-memory line to isolate parse cost
+ *          from syscall cost. Also checks both implementations agree.
+ *          The cached variant re-reads descriptors kept open in ProcFdCache.
+ *
+ * Build and run:
+ *   make bench_proc_stat && ./bench_proc_stat
+ */
+
+#include "../collector.h"
+#include "bench.h"
+
+/**
+ * @brief The original getProcessInfo() implementation, kept as the baseline
+ */
+static Proc legacyGetProcessInfo(int pid)
+{
+    Proc proc = {};
+    proc.pid = pid;
+
+    string comm_path = "/proc/" + to_string(pid) + "/comm";
+    ifstream comm_file(comm_path);
+    if (comm_file.is_open())
+    {
+        getline(comm_file, proc.name);
+        if (!proc.name.empty() && proc.name.back() == '\n')
+        {
+            proc.name.pop_back();
+        }
+    }
+
+    string stat_path = "/proc/" + to_string(pid) + "/stat";
+    ifstream stat_file(stat_path);
+    if (stat_file.is_open())
+    {
+        string line;
+        getline(stat_file, line);
+
+        size_t first_paren = line.find('(');
+        size_t last_paren = line.rfind(')');
+
+        if (first_paren != string::npos && last_paren != string::npos && last_paren > first_paren)
+        {
+            string pid_str = line.substr(0, first_paren);
+            proc.pid = stoi(pid_str);
+
+            string full_name = line.substr(first_paren + 1, last_paren - first_paren - 1);
+            if (proc.name.empty())
+            {
+                proc.name = full_name;
+            }
+
+            string remaining = line.substr(last_paren + 1);
+            istringstream iss(remaining);
+            vector<string> fields;
+            string field;
+
+            while (iss >> field)
+            {
+                fields.push_back(field);
+            }
+
+            if (fields.size() >= 22)
+            {
+                proc.state = fields[0][0];
+                proc.utime = stoll(fields[11]);
+                proc.stime = stoll(fields[12]);
+                proc.vsize = stoll(fields[20]);
+                proc.rss = stoll(fields[21]);
+            }
+        }
+    }
+
+    return proc;
+}
+
+static vector<int> listPids()
+{
+    vector<int> pids;
+    DIR *dir = opendir("/proc");
+    if (dir == nullptr)
+        return pids;
+
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != nullptr)
+    {
+        if (entry->d_name[0] >= '1' && entry->d_name[0] <= '9')
+            pids.push_back(atoi(entry->d_name));
+    }
+    closedir(dir);
+    return pids;
+}
+
+int main()
+{
+    vector<int> pids = listPids();
+    printf("Benchmarking /proc/[pid]/stat over %zu processes\n\n", pids.size());
+
+    // Sanity check: both implementations must agree on the fields they share
+    int mismatches = 0;
+    for (int pid : pids)
+    {
+        Proc a = legacyGetProcessInfo(pid);
+        Proc b = getProcessInfo(pid);
+        if (a.name != b.name || a.state != b.state || a.vsize != b.vsize)
+            mismatches++; // processes may legitimately change between reads
+    }
+    printf("Field mismatches between implementations: %d (expected ~0, live data)\n\n", mismatches);
+
+    double before = runBenchmark("getProcessInfo (legacy, comm+stat)", 20, pids.size(), [&]
+                                 {
+        for (int pid : pids)
+            doNotOptimize(legacyGetProcessInfo(pid)); });
+
+    double after = runBenchmark("getProcessInfo (current)", 20, pids.size(), [&]
+                                {
+        for (int pid : pids)
+            doNotOptimize(getProcessInfo(pid)); });
+
+    ProcFdCache cache;
+    runBenchmark("getProcessInfo (cached fd, pread)", 20, pids.size(), [&]
+                 {
+        for (int pid : pids)
+            doNotOptimize(getProcessInfo(cache, pid)); });
+
+    // Parse-only cost, using a line with a hostile comm name
+    const char line[] = "4242 (a) (b c)) S 1 4242 4242 0 -1 4194560 1234 0 0 0 "
+                        "567 89 0 0 20 0 3 0 123456 987654321 4321 18446744073709551615 "
+                        "1 1 0 0 0 0 0 4096 0 0 0 0 17 2 0 0 0 0 0\n";
+    ProcStat stat;
+    runBenchmark("parseProcStat (in-memory line)", 200000, 1, [&]
+                 {
+        parseProcStat(line, sizeof(line) - 1, stat);
+        doNotOptimize(stat); });
+    printf("  parsed comm=\"%s\" state=%c utime=%lld stime=%lld vsize=%lld rss=%lld\n",
+           stat.comm, stat.state, stat.utime, stat.stime, stat.vsize, stat.rss);
+
+    printf("\nSpeedup per process: %.2fx\n", before / after);
+    return 0;
+}
@@ -0,0 +1,130 @@
+/**
+ * @file bench_publish.cpp
+ * @brief Worst-case frame stalls when the render thread reads collector data
+ * @details A producer thread stands in for the sampler. Each tick it reads
+ *          /proc/net/dev and then sleeps a few milliseconds to emulate a
+ *          /proc read that has got stuck. Meanwhile a consumer thread stands
+ *          in for the render thread: it takes the latest data once per
+ *          "frame" and records how long that access took.
+ *
+ *          Three hand-over schemes are compared:
+ *          - mutex held across the collection, as parseNetworkDevFile() did
+ *          - mutex held only while copying, as the CPU/thermal/fan histories did
+ *          - TripleBuffer publication (current code)
+ *
+ * Build and run:
+ *   make bench_publish && ./bench_publish
+ */
+
+#include "../collector.h"
+#include "bench.h"
+
+/**
+ * @brief Payload similar to the network snapshot: a parsed file plus a history
+ */
+struct Payload
+{
+    string dev_file;
+    vector<float> history;
+};
+
+static const int FRAMES = 400;
+static const auto STALL = chrono::milliseconds(5); // emulated slow /proc read
+static const auto FRAME_INTERVAL = chrono::milliseconds(2);
+
+static void collect(Payload &out)
+{
+    ifstream file("/proc/net/dev");
+    out.dev_file.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+    this_thread::sleep_for(STALL);
+    out.history.assign(100, 1.0f);
+}
+
+/**
+ * @brief Runs producer and consumer and prints the per-frame access latency
+ * @param name Label for the results line
+ * @param produce Called repeatedly by the producer thread
+ * @param consume Called once per frame by the consumer thread
+ */
+template <typename Produce, typename Consume>
+static void runScenario(const char *name, Produce produce, Consume consume)
+{
+    atomic<bool> running(true);
+    thread producer([&]
+                    {
+        while (running.load())
+            produce(); });
+
+    vector<double> stalls_us;
+    stalls_us.reserve(FRAMES);
+    for (int frame = 0; frame < FRAMES; frame++)
+    {
+        auto start = chrono::steady_clock::now();
+        consume();
+        stalls_us.push_back(chrono::duration<double, micro>(chrono::steady_clock::now() - start).count());
+        this_thread::sleep_for(FRAME_INTERVAL);
+    }
+
+    running.store(false);
+    producer.join();
+
+    sort(stalls_us.begin(), stalls_us.end());
+    double p50 = stalls_us[stalls_us.size() / 2];
+    double p99 = stalls_us[stalls_us.size() * 99 / 100];
+    printf("%-40s p50 %9.1f us   p99 %9.1f us   max %9.1f us\n", name, p50, p99, stalls_us.back());
+}
+
+int main()
+{
+    printf("Frame data access latency, %d frames, producer stalls %lld ms per tick\n\n",
+           FRAMES, (long long)STALL.count());
+
+    // Before: the whole collection runs under the lock the renderer needs
+    {
+        mutex lock_;
+        Payload shared;
+        runScenario("mutex held during collection", [&]
+                    {
+            lock_guard<mutex> lock(lock_);
+            collect(shared); },
+                    [&]
+                    {
+            lock_guard<mutex> lock(lock_);
+            doNotOptimize(shared.history.size()); });
+    }
+
+    // Before: collection outside the lock, copy under it
+    {
+        mutex lock_;
+        Payload shared;
+        runScenario("mutex held during copy", [&]
+                    {
+            Payload fresh;
+            collect(fresh);
+            lock_guard<mutex> lock(lock_);
+            shared = fresh; },
+                    [&]
+                    {
+            Payload copy;
+            {
+                lock_guard<mutex> lock(lock_);
+                copy = shared;
+            }
+            doNotOptimize(copy.history.size()); });
+    }
+
+    // After: lock-free triple buffer
+    {
+        TripleBuffer<Payload> buffer;
+        runScenario("TripleBuffer publish/read", [&]
+                    {
+            collect(buffer.writeBuffer());
+            buffer.publish(); },
+                    [&]
+                    {
+            const Payload &latest = buffer.read();
+            doNotOptimize(latest.history.size()); });
+    }
+
+    return 0;
+}
@@ -0,0 +1,415 @@
+/**
+ * @file bench_suite.cpp
+ * @brief Collector, parser and view benchmarks over fixture trees, with JSON output
+ * @details Runs every benchmark once per fixture tree given on the command
+ *          line (see tools/gen_fixture.cpp), reading /proc and /sys through
+ *          a FileTreeSource rooted at the fixture, so results depend on the
+ *          fixture size rather than on what the build machine is running.
+ *
+ *          The process table itself is drawn in a headless ImGui context (no
+ *          window or renderer: NewFrame() to Render() on a fixed 1280x720
+ *          display), which measures the CPU the render thread spends on it.
+ *
+ *          Results are written as JSON, one object per benchmark and fixture.
+ *          With --compare, a previous results file is loaded and any
+ *          benchmark that got slower by more than the threshold is reported
+ *          (and the exit status is 2), so regressions show up between builds.
+ *
+ * Build and run:
+ *   make bench                     (generates fixtures, runs, writes bench_results.json)
+ *   ./bench_suite [--json OUT] [--compare OLD] [--threshold PCT] FIXTURE_DIR...
+ */
+
+#include "../header.h"
+#include "bench.h"
+#include <random>
+
+#ifndef BENCH_GIT_REV
+#define BENCH_GIT_REV "unknown"
+#endif
+
+struct BenchResult
+{
+    string name;
+    string fixture;
+    size_t processes;
+    double ns_per_item;
+    long items;
+    int iterations;
+};
+
+static vector<BenchResult> results;
+
+/**
+ * @brief Runs one calibrated benchmark and records it under @p fixture
+ */
+template <typename Fn>
+static void measure(const string &fixture, size_t processes, const char *name, long items, Fn fn)
+{
+    int iterations = 0;
+    double ns = runCalibratedBenchmark(name, max(items, 1L), fn, iterations);
+    results.push_back({name, fixture, processes, ns, max(items, 1L), iterations});
+}
+
+// =============================================================================
+// HEADLESS IMGUI
+// =============================================================================
+
+/**
+ * @brief Creates an ImGui context that can run frames without a backend
+ */
+static void createHeadlessImGui()
+{
+    ImGui::CreateContext();
+    ImGuiIO &io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1280, 720);
+    io.DeltaTime = 1.0f / 60.0f;
+
+    // NewFrame() requires a built font atlas; the pixels are never uploaded
+    unsigned char *pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+}
+
+/**
+ * @brief One complete frame holding only the process table, in a window
+ *        the size of the table's half of the GUI
+ */
+static void processTableFrame(const shared_ptr<const ProcessSnapshot> &snapshot)
+{
+    ImGui::NewFrame();
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(ImVec2(640, 720));
+    ImGui::Begin("Processes");
+    renderProcessTable(snapshot);
+    ImGui::End();
+    ImGui::Render();
+    doNotOptimize(ImGui::GetDrawData()->TotalVtxCount);
+}
+
+// =============================================================================
+// BENCHMARKS
+// =============================================================================
+
+/**
+ * @brief Every benchmark, against the fixture tree at @p root
+ */
+static void runFixture(const string &root)
+{
+    setDataSource(make_unique<FileTreeSource>(root));
+    process_events_enabled = false;
+    taskstats_enabled = false;
+
+    // Collect the fixture's processes once for the view benchmarks
+    ProcessScanner scanner(process_scan_workers);
+    vector<Proc> processes = scanner.scan();
+    vector<int> pids;
+    for (const Proc &proc : processes)
+        pids.push_back(proc.pid);
+
+    string fixture = root.substr(root.find_last_of('/') + 1);
+    size_t n = processes.size();
+    printf("\n== %s (%zu processes) ==\n", root.c_str(), n);
+
+    // Collectors
+    measure(fixture, n, "getProcessInfo (open/read/close)", (long)pids.size(), [&]
+            {
+        for (int pid : pids)
+            doNotOptimize(getProcessInfo(pid).pid); });
+
+    ProcFdCache cache;
+    measure(fixture, n, "getProcessInfo (cached descriptor)", (long)pids.size(), [&]
+            {
+        for (int pid : pids)
+            doNotOptimize(getProcessInfo(cache, pid).pid); });
+
+    measure(fixture, n, "getAllProcesses", (long)n, [&]
+            { doNotOptimize(scanner.scan().size()); });
+
+    measure(fixture, n, "getProcessCounts", (long)n, [&]
+            { doNotOptimize(getProcessCounts(processes).total); });
+
+    measure(fixture, n, "getMemoryInfo", 1, []
+            { doNotOptimize(getMemoryInfo().total_ram); });
+
+    measure(fixture, n, "parseNetworkDevFile", 1, []
+            { parseNetworkDevFile(); });
+
+    measure(fixture, n, "getCurrentCPUStats", 1, []
+            { doNotOptimize(getCurrentCPUStats().user); });
+
+    // Formatting, over sizes spanning every unit
+    vector<unsigned long> sizes;
+    for (int shift = 0; shift < 48; shift += 3)
+        sizes.push_back((1UL << shift) + shift * 1000UL);
+
+    measure(fixture, n, "formatBytes", (long)sizes.size(), [&]
+            {
+        for (unsigned long size : sizes)
+            doNotOptimize(formatBytes(size).size()); });
+
+    measure(fixture, n, "formatNetworkBytes", (long)sizes.size(), [&]
+            {
+        for (unsigned long size : sizes)
+            doNotOptimize(formatNetworkBytes(size).size()); });
+
+    // Views: filter and sort the process table as the render thread does.
+    // The fixture is a single tick, so give every process a CPU% to sort on.
+    mt19937 rng(1);
+    uniform_real_distribution<float> cpu(0.0f, 100.0f);
+    for (Proc &proc : processes)
+        proc.cpu_percent = cpu(rng);
+
+    measure(fixture, n, "filterProcesses (\"py\")", (long)n, [&]
+            { doNotOptimize(filterProcesses(processes, "py").size()); });
+
+    measure(fixture, n, "filterProcesses (no match)", (long)n, [&]
+            { doNotOptimize(filterProcesses(processes, "zzzz").size()); });
+
+    const unsigned long total_ram = 64UL << 30;
+    const struct
+    {
+        const char *name;
+        int column;
+    } sort_columns[] = {
+        {"sort comparator: PID (copy + sort)", 0},
+        {"sort comparator: Name (copy + sort)", 1},
+        {"sort comparator: CPU % (copy + sort)", 3},
+        {"sort comparator: Memory % (copy + sort)", 4},
+    };
+    for (const auto &column : sort_columns)
+    {
+        measure(fixture, n, column.name, (long)n, [&]
+                {
+            vector<Proc> sorted = processes;
+            sort(sorted.begin(), sorted.end(), [&](const Proc &a, const Proc &b)
+                 { return compareProcesses(a, b, column.column, false, total_ram); });
+            doNotOptimize(sorted.data()); });
+    }
+
+    // The process table view: filtered and sorted row indices
+    auto snapshot = make_shared<ProcessSnapshot>();
+    snapshot->processes = processes;
+    sort(snapshot->processes.begin(), snapshot->processes.end(), [](const Proc &a, const Proc &b)
+         { return a.pid < b.pid; });
+    snapshot->generation = 1;
+
+    measure(fixture, n, "buildProcessSortKeys", (long)n, [&]
+            { buildProcessSortKeys(*snapshot); });
+
+    measure(fixture, n, "buildProcessLowerNames", (long)n, [&]
+            { buildProcessLowerNames(*snapshot); });
+
+    ProcessTableView view;
+    const vector<ProcessSortSpec> by_cpu = {{PROCESS_COLUMN_CPU, false}};
+    measure(fixture, n, "ProcessTableView: new snapshot (CPU % sort)", (long)n, [&]
+            {
+        snapshot->generation++;
+        view.update(snapshot, "", by_cpu);
+        doNotOptimize(view.size()); });
+
+    // A sort change re-sorts every row; alternate the direction so each call does
+    const struct
+    {
+        const char *name;
+        vector<ProcessSortSpec> specs;
+    } sort_changes[] = {
+        {"ProcessTableView: sort change (PID)", {{PROCESS_COLUMN_PID, false}}},
+        {"ProcessTableView: sort change (Name)", {{PROCESS_COLUMN_NAME, false}}},
+        {"ProcessTableView: sort change (CPU %)", {{PROCESS_COLUMN_CPU, false}}},
+        {"ProcessTableView: sort change (Memory %)", {{PROCESS_COLUMN_MEMORY, false}}},
+        {"ProcessTableView: sort change (State, CPU %)", {{PROCESS_COLUMN_STATE, true}, {PROCESS_COLUMN_CPU, false}}},
+    };
+    for (const auto &change : sort_changes)
+    {
+        vector<ProcessSortSpec> specs[2] = {change.specs, change.specs};
+        specs[1][0].ascending = !specs[1][0].ascending;
+        int flip = 0;
+        measure(fixture, n, change.name, (long)n, [&]
+                {
+            flip ^= 1;
+            view.update(snapshot, "", specs[flip]);
+            doNotOptimize(view.size()); });
+    }
+
+    // Typing in the filter box, sorted by CPU % (ns per keystroke): type a
+    // name one character at a time, then delete it again
+    const char *const typed[] = {"g", "gn", "gno", "gnom", "gnome", "gnom", "gno", "gn", "g", ""};
+    measure(fixture, n, "ProcessTableView: keystroke (type, delete)", 10, [&]
+            {
+        for (const char *filter : typed)
+            view.update(snapshot, filter, by_cpu);
+        doNotOptimize(view.size()); });
+
+    // Worst case: every keystroke replaces the filter with an unrelated one
+    const char *const unrelated[] = {"py", "sh"};
+    int next = 0;
+    measure(fixture, n, "ProcessTableView: keystroke (unrelated filter)", 1, [&]
+            {
+        next ^= 1;
+        view.update(snapshot, unrelated[next], by_cpu);
+        doNotOptimize(view.size()); });
+    view.update(snapshot, "", by_cpu);
+
+    measure(fixture, n, "ProcessTableView: unchanged", 1, [&]
+            {
+        view.update(snapshot, "", by_cpu);
+        doNotOptimize(view.size()); });
+
+    // The whole process table, as drawn every frame (ns per frame)
+    measure(fixture, n, "renderProcessTable (frame)", 1, [&]
+            { processTableFrame(snapshot); });
+}
+
+// =============================================================================
+// JSON
+// =============================================================================
+
+static string jsonEscape(const string &text)
+{
+    string out;
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\')
+            out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+/**
+ * @brief Writes the results, one benchmark per line so files diff cleanly
+ */
+static bool writeJson(const string &path)
+{
+    FILE *file = fopen(path.c_str(), "w");
+    if (file == nullptr)
+        return false;
+
+    time_t now = time(nullptr);
+    char date[32];
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+
+    fprintf(file, "{\n  \"git\": \"%s\",\n  \"compiler\": \"%s\",\n  \"date\": \"%s\",\n"
+                  "  \"hardware_threads\": %u,\n  \"scan_workers\": %d,\n  \"results\": [\n",
+            BENCH_GIT_REV, jsonEscape(__VERSION__).c_str(), date, thread::hardware_concurrency(),
+            process_scan_workers);
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const BenchResult &r = results[i];
+        fprintf(file, "    {\"name\": \"%s\", \"fixture\": \"%s\", \"processes\": %zu, "
+                      "\"ns_per_item\": %.2f, \"items\": %ld, \"iterations\": %d}%s\n",
+                jsonEscape(r.name).c_str(), jsonEscape(r.fixture).c_str(), r.processes,
+                r.ns_per_item, r.items, r.iterations, i + 1 < results.size() ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+    fclose(file);
+    return true;
+}
+
+/**
+ * @brief Extracts the string value of "key" from one result line
+ */
+static string jsonString(const string &line, const char *key)
+{
+    string pattern = string("\"") + key + "\": \"";
+    size_t start = line.find(pattern);
+    if (start == string::npos)
+        return "";
+    start += pattern.size();
+
+    string value;
+    for (size_t i = start; i < line.size() && line[i] != '"'; i++)
+    {
+        if (line[i] == '\\' && i + 1 < line.size())
+            i++;
+        value += line[i];
+    }
+    return value;
+}
+
+/**
+ * @brief Compares against a results file written by writeJson()
+ * @return Number of benchmarks slower by more than @p threshold_percent
+ */
+static int compareWith(const string &path, double threshold_percent)
+{
+    ifstream file(path);
+    if (!file.is_open())
+    {
+        fprintf(stderr, "cannot read %s\n", path.c_str());
+        return 0;
+    }
+
+    map<pair<string, string>, double> previous;
+    string line;
+    while (getline(file, line))
+    {
+        size_t ns = line.find("\"ns_per_item\": ");
+        if (ns == string::npos)
+            continue;
+        previous[{jsonString(line, "name"), jsonString(line, "fixture")}] = atof(line.c_str() + ns + 15);
+    }
+
+    int regressions = 0;
+    printf("\nCompared with %s (threshold %.0f%%):\n", path.c_str(), threshold_percent);
+    for (const BenchResult &r : results)
+    {
+        auto it = previous.find({r.name, r.fixture});
+        if (it == previous.end() || it->second <= 0)
+            continue;
+
+        double change = (r.ns_per_item / it->second - 1.0) * 100.0;
+        if (fabs(change) < threshold_percent)
+            continue;
+        printf("  %-10s %-40s %10.1f -> %10.1f ns/item  %+6.1f%%%s\n", r.fixture.c_str(), r.name.c_str(),
+               it->second, r.ns_per_item, change, change > 0 ? "  REGRESSION" : "");
+        if (change > 0)
+            regressions++;
+    }
+    if (regressions == 0)
+        printf("  no regressions\n");
+    return regressions;
+}
+
+int main(int argc, char **argv)
+{
+    string json_path = "bench_results.json";
+    string compare_path;
+    double threshold = 10.0;
+    vector<string> fixtures;
+
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if (arg == "--json" && i + 1 < argc)
+            json_path = argv[++i];
+        else if (arg == "--compare" && i + 1 < argc)
+            compare_path = argv[++i];
+        else if (arg == "--threshold" && i + 1 < argc)
+            threshold = atof(argv[++i]);
+        else
+            fixtures.push_back(arg);
+    }
+    if (fixtures.empty())
+    {
+        fprintf(stderr, "Usage: %s [--json OUT] [--compare OLD] [--threshold PCT] FIXTURE_DIR...\n", argv[0]);
+        return 1;
+    }
+
+    createHeadlessImGui();
+    for (const string &fixture : fixtures)
+        runFixture(fixture);
+
+    // Compare first: --compare may name the file about to be overwritten
+    int regressions = compare_path.empty() ? 0 : compareWith(compare_path, threshold);
+
+    if (!writeJson(json_path))
+    {
+        fprintf(stderr, "cannot write %s\n", json_path.c_str());
+        return 1;
+    }
+    printf("\nWrote %zu results to %s\n", results.size(), json_path.c_str());
+    return regressions > 0 ? 2 : 0;
+}
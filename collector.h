@@ -0,0 +1,810 @@
+#ifndef collector_H
+#define collector_H
+
+// Collection side of the monitor: data types, collectors, the sampler and the
+// metric store. Nothing declared here depends on ImGui, SDL or OpenGL, so the
+// headless collector (headless.cpp) builds from these files alone; the GUI
+// adds its rendering declarations in header.h.
+#include <stdio.h>
+#include <dirent.h>
+#include <vector>
+#include <iostream>
+#include <cstring>
+#include <string>
+#include <cmath>
+#include <sstream>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <numeric>
+#include <atomic>
+#include <mutex>
+#include <filesystem>
+#include <regex>
+#include <pwd.h>   // For getpwuid
+#include <fstream> // lib to read from file
+#include <set>     // For process selection
+// for the name of the computer and the logged in user
+#include <unistd.h>
+#include <limits.h>
+// this is for us to get the cpu information
+// mostly in unix system
+// not sure if it will work in windows
+#include <cpuid.h>
+// this is for the memory usage and other memory visualization
+// for linux gotta find a way for windows
+#include <sys/types.h>
+#include <sys/sysinfo.h>
+#include <sys/statvfs.h>
+#include <ctime>       // for time and date
+#include <sys/types.h> // ifconfig ip addresses
+#include <ifaddrs.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <map>
+#include <memory>
+#include <list>
+#include <deque>
+#include <condition_variable>
+#include <unordered_map>
+#include "triple_buffer.h"
+#include "ring_buffer.h"
+
+using namespace std;
+
+// samples kept by every metric history (CPU, thermal, fan graphs)
+#define HISTORY_DEPTH 100
+typedef RingBuffer<float, HISTORY_DEPTH> MetricHistory;
+
+// min/max/avg of the samples that fell into one rollup bucket
+struct RollupBucket
+{
+    float min;
+    float max;
+    float avg;
+    int count;
+};
+
+// rollup tiers kept next to the raw samples, coarsest last
+enum RollupTier
+{
+    ROLLUP_10S,
+    ROLLUP_1M,
+    ROLLUP_1H,
+    ROLLUP_TIER_COUNT
+};
+
+// Gorilla-style compressed (timestamp, value) series: delta-of-delta
+// millisecond timestamps and XOR-encoded floats. Full blocks are sealed and
+// shared between copies, so copying a series only copies the open block.
+class CompressedSeries
+{
+public:
+    explicit CompressedSeries(chrono::milliseconds retention);
+
+    void append(int64_t time_ms, float value);
+    size_t size() const;  // samples retained
+    size_t bytes() const; // encoded bytes retained
+    size_t decode(vector<float> &values, vector<int64_t> *times = nullptr) const; // oldest first
+
+    static const uint32_t BLOCK_SAMPLES = 512;
+
+private:
+    struct Block
+    {
+        vector<uint8_t> bits;
+        size_t bit_count = 0;
+        uint32_t count = 0;
+        int64_t first_time = 0;
+        int64_t last_time = 0;
+        // encoder state for the next append
+        int64_t prev_delta = 0;
+        uint32_t prev_value = 0;
+        int prev_leading = -1;
+        int prev_trailing = 0;
+    };
+
+    void sealOpenBlock();
+    static void decodeBlock(const Block &block, vector<float> &values, vector<int64_t> *times);
+
+    chrono::milliseconds retention;
+    deque<shared_ptr<const Block>> sealed; // oldest first
+    Block open;
+};
+
+// history of one metric: the last HISTORY_DEPTH raw samples, every sample of
+// the last hour (compressed), plus 10 s buckets for 1 hour, 1 min buckets for
+// 24 hours and 1 h buckets for 7 days. Every sample updates all tiers in O(1).
+class RollupHistory
+{
+public:
+    void push(float value, chrono::steady_clock::time_point now);
+
+    const MetricHistory &raw() const { return raw_samples; }
+    const CompressedSeries &fullResolution() const { return full_resolution; }
+    size_t bucketCount(RollupTier tier) const;
+    RollupBucket bucket(RollupTier tier, size_t index) const; // 0 = oldest; the last one is still filling
+    static chrono::seconds bucketWidth(RollupTier tier);
+
+private:
+    struct OpenBucket
+    {
+        RollupBucket bucket = {};
+        long long index = LLONG_MIN; // bucket number on the history timeline; LLONG_MIN = none yet
+    };
+
+    template <size_t N>
+    void addToTier(RingBuffer<RollupBucket, N> &closed, OpenBucket &open, float value, long long index);
+
+    MetricHistory raw_samples;
+    CompressedSeries full_resolution{chrono::hours(1)};
+    RingBuffer<RollupBucket, 360> ten_seconds;
+    RingBuffer<RollupBucket, 1440> minutes;
+    RingBuffer<RollupBucket, 168> hours;
+    OpenBucket open[ROLLUP_TIER_COUNT];
+};
+
+struct CPUStats
+{
+    long long int user;
+    long long int nice;
+    long long int system;
+    long long int idle;
+    long long int iowait;
+    long long int irq;
+    long long int softirq;
+    long long int steal;
+    long long int guest;
+    long long int guestNice;
+};
+
+// accumulated totals from taskstats (nanoseconds, summed over all threads)
+struct TaskDelays
+{
+    unsigned long long cpu_run_ns;
+    unsigned long long cpu_delay_ns;
+    unsigned long long blkio_delay_ns;
+    unsigned long long swapin_delay_ns;
+};
+
+// processes `stat`
+struct Proc
+{
+    int pid;
+    string name;
+    char state;
+    long long int vsize;
+    long long int rss;
+    long long int utime;
+    long long int stime;
+    long long int starttime; // detects PID reuse between snapshots
+    float cpu_percent; // derived from the previous snapshot
+    bool has_taskstats; // delays.cpu_run_ns came from taskstats
+    bool has_delays; // delay totals are valid (kernel delay accounting is on)
+    TaskDelays delays;
+    float run_delay_percent; // time spent waiting for a CPU, derived like cpu_percent
+    float io_delay_percent; // time spent waiting for block I/O and swap-in
+};
+
+// fields parsed from `/proc/[pid]/stat` without allocating
+#define PROC_STAT_BUFFER_SIZE 1024
+struct ProcStat
+{
+    int pid;
+    char comm[64];
+    size_t comm_len;
+    char state;
+    int ppid;
+    long long int utime;
+    long long int stime;
+    int num_threads;
+    long long int starttime;
+    long long int vsize;
+    long long int rss;
+};
+
+// process counts by state, derived from one scan
+struct ProcessCounts
+{
+    int total;
+    int running;
+    int sleeping;
+    int zombie;
+    int stopped;
+};
+
+// process lifecycle events seen by the proc connector between two scans
+struct ProcessEventCounts
+{
+    int forks;
+    int execs;
+    int exits;
+    int short_lived; // started and exited between two scans
+};
+
+// process table columns; the values are the ImGui column user IDs
+enum ProcessColumn
+{
+    PROCESS_COLUMN_PID,
+    PROCESS_COLUMN_NAME,
+    PROCESS_COLUMN_STATE,
+    PROCESS_COLUMN_CPU,
+    PROCESS_COLUMN_MEMORY,
+    PROCESS_COLUMN_RUN_DELAY,
+    PROCESS_COLUMN_IO_DELAY,
+    PROCESS_COLUMN_COUNT
+};
+
+// result of a single /proc walk, shared by the counts, the table and CPU%
+struct ProcessSnapshot
+{
+    vector<Proc> processes; // sorted by pid
+    ProcessCounts counts;
+    ProcessEventCounts events;     // lifecycle events since the previous snapshot
+    vector<string> short_lived;    // names of processes that never made a scan
+    bool events_active;            // events come from the proc connector
+    bool taskstats_active;         // taskstats supplied nanosecond CPU time
+    bool delays_active;            // ... and run/IO delay totals
+    uint64_t generation;
+    chrono::steady_clock::time_point taken_at;
+    // per column, one order-preserving key per process for radix sorting
+    // (see buildProcessSortKeys()); empty for the Name column
+    vector<uint32_t> sort_keys[PROCESS_COLUMN_COUNT];
+    // lowercased names back to back, for the name filter; process i spans
+    // [lower_name_offsets[i], lower_name_offsets[i + 1])
+    string lower_names;
+    vector<uint32_t> lower_name_offsets;
+};
+
+// per-process files kept open by ProcFdCache
+enum ProcFile
+{
+    PROC_FILE_STAT,
+    PROC_FILE_STATM,
+    PROC_FILE_IO,
+    PROC_FILE_COUNT
+};
+
+// pid-keyed cache of open `/proc/[pid]/*` descriptors, re-read with pread().
+// Bounded by RLIMIT_NOFILE with LRU eviction. Not thread-safe: owned by the
+// thread that scans /proc.
+class ProcFdCache
+{
+public:
+    explicit ProcFdCache(size_t max_open_fds = 0); // 0 = derive from RLIMIT_NOFILE
+    ~ProcFdCache();
+    ProcFdCache(const ProcFdCache &) = delete;
+    ProcFdCache &operator=(const ProcFdCache &) = delete;
+
+    ssize_t read(int pid, ProcFile file, char *buf, size_t size);
+    void beginScan();
+    void evictStale();
+    size_t openDescriptors() const { return open_fds; }
+    int procDirFd() const { return proc_dirfd; }
+    static size_t defaultCapacity();
+
+private:
+    struct Entry
+    {
+        int fds[PROC_FILE_COUNT] = {-1, -1, -1};
+        uint64_t last_scan = 0;
+        list<int>::iterator lru_position;
+    };
+
+    void closeEntry(Entry &entry);
+    void evict(int pid);
+    void makeRoom();
+
+    unordered_map<int, Entry> entries;
+    list<int> lru; // most recently used PID first
+    size_t capacity;
+    int proc_dirfd = -1; // per-pid files are opened relative to this
+    size_t open_fds = 0;
+    uint64_t scan_generation = 0;
+};
+
+// taskstats generic netlink client; one per scanning thread (not thread-safe).
+// Queries fail cleanly when the family is missing or the caller lacks permission.
+struct GenlRequest;
+class TaskstatsClient
+{
+public:
+    TaskstatsClient() = default;
+    ~TaskstatsClient();
+    TaskstatsClient(const TaskstatsClient &) = delete;
+    TaskstatsClient &operator=(const TaskstatsClient &) = delete;
+
+    bool open();
+    bool query(int tgid, TaskDelays &out);
+
+private:
+    bool resolveFamily();
+    ssize_t transact(GenlRequest &req, char *buf, size_t size);
+
+    int sock = -1;
+    uint16_t family_id = 0;
+    uint32_t seq = 0;
+    bool failed = false; // open failed or permission denied; stop trying
+};
+
+// scans /proc with a pool of workers, each with its own ProcFdCache.
+// PIDs are sharded by pid % workers so descriptors stay on one worker.
+class ProcessScanner
+{
+public:
+    explicit ProcessScanner(int workers);
+    ~ProcessScanner();
+    ProcessScanner(const ProcessScanner &) = delete;
+    ProcessScanner &operator=(const ProcessScanner &) = delete;
+
+    vector<Proc> scan();
+    int workerCount() const { return (int)workers.size(); }
+
+private:
+    struct Worker
+    {
+        explicit Worker(size_t max_open_fds) : cache(max_open_fds) {}
+        ProcFdCache cache;
+        TaskstatsClient taskstats;
+        vector<int> pids;
+        vector<Proc> results; // thread-local output, merged after the scan
+    };
+
+    void runWorker(Worker &worker);
+    void workerLoop(int index);
+
+    vector<unique_ptr<Worker>> workers; // workers[0] runs on the calling thread
+    vector<thread> threads;
+    vector<int> all_pids;
+    mutex pool_mutex;
+    condition_variable work_ready;
+    condition_variable work_done;
+    uint64_t scan_generation = 0;
+    bool use_taskstats = false; // decided once per scan, before workers start
+    bool delays_valid = false;  // kernel.task_delayacct was on for this scan
+    size_t pending_workers = 0;
+    bool stopping = false;
+};
+
+struct IP4
+{
+    string name;
+    char addressBuffer[INET_ADDRSTRLEN];
+};
+
+struct Networks
+{
+    vector<IP4> ip4s;
+};
+
+struct RX
+{
+    uint64_t bytes;
+    uint64_t packets;
+    uint64_t errs;
+    uint64_t drop;
+    uint64_t fifo;
+    uint64_t frame;
+    uint64_t compressed;
+    uint64_t multicast;
+};
+
+struct TX
+{
+    uint64_t bytes;
+    uint64_t packets;
+    uint64_t errs;
+    uint64_t drop;
+    uint64_t fifo;
+    uint64_t colls;
+    uint64_t carrier;
+    uint64_t compressed;
+};
+
+// /proc/net/dev counters and interface addresses from one sampler tick
+struct NetworkSnapshot
+{
+    map<string, RX> rx;
+    map<string, TX> tx;
+    Networks networks;
+    bool ready; // /proc/net/dev has been parsed at least once
+};
+
+struct SystemInfo
+{
+    string os_name;
+    string hostname;
+    string username;
+    string cpu_model;
+    int total_processes;
+    int running_processes;
+    int sleeping_processes;
+    int zombie_processes;
+    int stopped_processes;
+};
+
+struct MemoryInfo
+{
+    unsigned long total_ram;
+    unsigned long available_ram;
+    unsigned long used_ram;
+    unsigned long total_swap;
+    unsigned long used_swap;
+    unsigned long total_disk;
+    unsigned long used_disk;
+};
+
+struct ThermalInfo
+{
+    float temperature;
+    bool available;
+};
+
+struct FanInfo
+{
+    int speed;
+    int level;
+    bool active;
+    bool available;
+};
+
+// system information
+string CPUinfo();
+const char *getOsName();
+string getHostname();
+string getUsername();
+SystemInfo getSystemInfo();
+void updateSystemInfo();
+ProcessCounts getProcessCounts(const vector<Proc> &processes);
+CPUStats getCurrentCPUStats();
+float calculateCPUUsage(CPUStats prev, CPUStats curr);
+
+// System information snapshot published by the sampler
+const SystemInfo &getCachedSystemInfo();
+
+// CPU Graph Global Variables (extern declarations)
+extern atomic<bool> graph_paused;
+extern atomic<float> graph_fps;
+extern atomic<float> current_cpu_usage;
+
+// Thermal Global Variables (extern declarations)
+extern atomic<bool> thermal_paused;
+extern atomic<float> thermal_fps;
+extern atomic<float> current_temperature;
+extern atomic<bool> thermal_available;
+
+// Fan Global Variables (extern declarations)
+extern atomic<bool> fan_paused;
+extern atomic<float> fan_fps;
+extern atomic<int> current_fan_speed;
+extern atomic<int> current_fan_level;
+extern atomic<bool> fan_active;
+extern atomic<bool> fan_available;
+
+// Persistent metric store (store.cpp), enabled with --store PATH
+enum StoreSeries
+{
+    STORE_CPU,
+    STORE_THERMAL,
+    STORE_FAN,
+    STORE_NET_RX, // bytes/s received over all interfaces
+    STORE_NET_TX, // bytes/s transmitted over all interfaces
+    STORE_SERIES_COUNT
+};
+
+// one fixed-size record of the on-disk store
+struct StoreRecord
+{
+    int64_t time_ns; // wall clock (system_clock), survives reboots
+    float value;
+    uint32_t reserved;
+};
+
+extern string metric_store_path;
+extern size_t metric_store_size_mb;
+bool openMetricStore(const string &path, size_t size_mb);
+void closeMetricStore();
+bool metricStoreOpen();
+void appendMetric(StoreSeries series, float value);
+size_t storedMetricCount(StoreSeries series);
+StoreRecord storedMetric(StoreSeries series, size_t i);
+size_t restoreMetricHistory(StoreSeries series, RollupHistory &history, chrono::seconds max_age);
+void restoreHistories();
+
+// Raw source capture (trace.cpp), enabled with --record PATH
+enum TraceRecordKind : uint8_t
+{
+    TRACE_FILE,      // data is the file contents
+    TRACE_MISSING,   // the file could not be opened or read; no data
+    TRACE_DIRECTORY, // data is the NUL-terminated entry names
+};
+
+const uint32_t TRACE_VERSION = 1;
+extern const char TRACE_MAGIC[8];
+
+struct TraceFileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t record_header_size; // sizeof(TraceRecordHeader)
+    uint64_t start_time_ns;      // steady_clock when recording started
+};
+
+// precedes the path and data bytes of every record
+struct TraceRecordHeader
+{
+    uint64_t time_ns; // steady_clock (CLOCK_MONOTONIC) at the read
+    uint32_t data_len;
+    uint16_t path_len;
+    TraceRecordKind kind;
+    uint8_t reserved;
+};
+
+bool openTraceRecorder(const string &path);
+void closeTraceRecorder();
+bool traceRecorderActive();
+uint64_t traceRecorderBytes();
+void recordSourceRead(const char *path, const char *data, size_t len);
+void recordSourceMissing(const char *path);
+void recordSourceListing(const char *path, const string &names);
+
+// where the collectors' /proc and /sys reads come from (source.cpp). Paths are
+// always the live absolute paths ("/proc/stat"); each backend maps them.
+class DataSource
+{
+public:
+    virtual ~DataSource() = default;
+    virtual bool readFile(const char *path, string &out) = 0;
+    virtual bool listDirectory(const char *path, vector<string> &names) = 0; // sorted
+    // prefix of a real directory tree holding the files ("" = live system), so
+    // the process scan can keep its descriptor cache; nullptr if not file-backed
+    virtual const char *fileRoot() const { return nullptr; }
+};
+
+// the live system (root "") or a fixture tree laid out like / (--root DIR)
+class FileTreeSource : public DataSource
+{
+public:
+    explicit FileTreeSource(string root);
+    bool readFile(const char *path, string &out) override;
+    bool listDirectory(const char *path, vector<string> &names) override;
+    const char *fileRoot() const override { return root.c_str(); }
+
+private:
+    string root;
+};
+
+// plays back a --record trace, following the wall clock from the position
+// last passed to seek(); holds the final state once the trace ends
+class ReplaySource : public DataSource
+{
+public:
+    bool open(const string &path, string &error);
+    void seek(chrono::nanoseconds offset);
+    chrono::nanoseconds duration() const { return chrono::nanoseconds(duration_ns); }
+    bool readFile(const char *path, string &out) override;
+    bool listDirectory(const char *path, vector<string> &names) override;
+
+private:
+    struct Record
+    {
+        int64_t time_ns; // since recording started
+        size_t data_offset;
+        uint32_t data_len;
+        TraceRecordKind kind;
+    };
+
+    int64_t position() const;
+    const Record *lookup(const char *path) const;
+
+    vector<char> data;                              // the whole trace file
+    unordered_map<string, vector<Record>> records; // per path, in time order
+    int64_t duration_ns = 0;
+    atomic<int64_t> seek_offset_ns{0};
+    atomic<int64_t> seek_time_ns{0}; // steady_clock when seek() was called
+};
+
+DataSource &dataSource();
+void setDataSource(unique_ptr<DataSource> source);
+bool readSourceFile(const char *path, string &out);
+bool listSourceDirectory(const char *path, vector<string> &names);
+
+// CPU Graph Functions
+void updateCPUHistory();
+const RollupHistory &getCPUHistory();
+const CPUStats &latestCPUStats();
+
+// Thermal Graph Functions
+ThermalInfo getThermalInfo();
+void updateThermalHistory();
+const RollupHistory &getThermalHistory();
+
+// Fan Functions
+FanInfo getFanInfo();
+void updateFanHistory();
+const RollupHistory &getFanHistory();
+
+// Memory and Process Functions
+MemoryInfo getMemoryInfo();
+void updateMemoryInfo();
+const MemoryInfo &getCachedMemoryInfo();
+const MemoryInfo &latestMemoryInfo();
+float calculateMemoryUsage(unsigned long used, unsigned long total);
+string formatBytes(unsigned long bytes);
+bool parseProcStat(const char *buf, size_t len, ProcStat &out);
+bool readProcStat(int pid, ProcStat &out);
+bool readProcStat(ProcFdCache &cache, int pid, ProcStat &out);
+Proc getProcessInfo(int pid);
+Proc getProcessInfo(ProcFdCache &cache, int pid);
+bool listProcPids(int proc_dirfd, vector<int> &pids);
+extern int process_scan_workers;
+vector<Proc> getAllProcesses();
+
+// Taskstats CPU and delay accounting (optional, falls back to /proc/[pid]/stat)
+extern bool taskstats_enabled;
+bool delayAccountingEnabled();
+
+// Process lifecycle events (netlink proc connector, falls back to polling)
+extern bool process_events_enabled;
+bool startProcessEvents();
+void stopProcessEvents();
+bool processEventsActive();
+bool takeEventPids(vector<int> &pids);
+void beginEventResync();
+void finishEventResync(const vector<int> &pids);
+ProcessEventCounts takeProcessEventCounts(vector<string> &short_lived);
+
+void updateProcessSnapshot();
+shared_ptr<const ProcessSnapshot> getProcessSnapshot();
+shared_ptr<const ProcessSnapshot> latestProcessSnapshot();
+float calculateProcessMemory(const Proc &proc, unsigned long total_memory);
+vector<Proc> filterProcesses(const vector<Proc> &processes, const string &filter);
+bool compareProcesses(const Proc &a, const Proc &b, int column, bool ascending, unsigned long total_ram);
+void updateProcessCPUData(ProcessSnapshot &current, const ProcessSnapshot &previous);
+void buildProcessSortKeys(ProcessSnapshot &snapshot);
+void buildProcessLowerNames(ProcessSnapshot &snapshot);
+
+// one sort column of the process table, most significant first
+struct ProcessSortSpec
+{
+    int column; // ProcessColumn
+    bool ascending;
+    bool operator==(const ProcessSortSpec &other) const { return column == other.column && ascending == other.ascending; }
+};
+
+// the process table's rows as indices into one snapshot, filtered and sorted.
+// update() keeps the result for as long as the snapshot generation, the filter
+// and the sort are unchanged; a sort change only reorders the current rows.
+// Numeric columns are radix sorted on the snapshot's sort keys. A filter that
+// extends the previous one narrows the current rows, and the wider results
+// are kept so deleting characters again restores them. Render thread only.
+class ProcessTableView
+{
+public:
+    void update(const shared_ptr<const ProcessSnapshot> &snapshot, const char *filter,
+                const vector<ProcessSortSpec> &sort);
+
+    size_t size() const { return rows.size(); }
+    const Proc &row(size_t index) const { return snapshot->processes[rows[index]]; }
+    uint64_t rebuilds() const { return rebuild_count; } // row sets built since creation
+
+private:
+    void filterRows();
+    void narrowRows(const vector<uint32_t> &from);
+    void changeFilter(const char *new_filter);
+    bool nameMatches(uint32_t index);
+    void sortRows();
+    void radixSortRows(const vector<uint32_t> &keys, bool ascending);
+
+    shared_ptr<const ProcessSnapshot> snapshot; // keeps the indexed processes alive
+    uint64_t generation = 0;
+    string filter;
+    string lower_filter;
+    // results of shorter filters this one extends, widest first; valid for
+    // the current snapshot and sort
+    struct FilterStep
+    {
+        string lower_filter;
+        vector<uint32_t> rows;
+    };
+    vector<FilterStep> wider_results;
+    string lower_scratch; // one name, when the snapshot has no lower_names
+    vector<ProcessSortSpec> sort_specs;
+    vector<uint32_t> rows; // indices into snapshot->processes
+    bool rows_in_pid_order = true;
+    vector<uint64_t> sort_items[2]; // radix sort ping-pong buffers, (key << 32) | row
+    uint64_t rebuild_count = 0;
+};
+
+// Network Functions
+Networks getNetworkInterfaces();
+void parseNetworkDevFile();
+void updateNetworkStats();
+const NetworkSnapshot &getNetworkSnapshot();
+const NetworkSnapshot &latestNetworkSnapshot();
+void restoreNetworkHistories(chrono::seconds max_age);
+const RollupHistory &getNetworkRXHistory();
+const RollupHistory &getNetworkTXHistory();
+string formatNetworkBytes(uint64_t bytes);
+float calculateNetworkProgress(uint64_t bytes);
+
+// Prometheus text endpoint on localhost (metrics.cpp), enabled with --metrics-port PORT
+extern int metrics_port;
+bool startMetricsServer(int port);
+void stopMetricsServer();
+bool metricsServerActive();
+uint64_t metricsScrapeCount();
+void updateMetricsPage();
+
+// Sampler thread (runs every collector in the background)
+void startSampler();
+void stopSampler();
+void setSampleListener(void (*listener)()); // called on the sampler thread after each publishing cycle
+
+// cost of one collector, accumulated by the sampler over all of its runs
+struct CollectorCost
+{
+    const char *name;
+    uint64_t runs;
+    double last_ms;
+    double total_ms;
+    double max_ms;
+    uint64_t syscalls;    // issued against /proc and /sys, scan workers included
+    uint64_t bytes_read;
+    uint64_t allocations; // heap allocations on the sampler and scan workers
+};
+const vector<CollectorCost> &getCollectorCosts(); // render thread only
+
+// Monitor self-overhead counters (overhead.cpp)
+extern atomic<uint64_t> collector_syscalls;
+extern atomic<uint64_t> collector_bytes_read;
+inline void countCollectorIo(uint64_t syscalls, uint64_t bytes = 0)
+{
+    collector_syscalls.fetch_add(syscalls, memory_order_relaxed);
+    if (bytes > 0)
+        collector_bytes_read.fetch_add(bytes, memory_order_relaxed);
+}
+void countAllocationsForCollectors();
+uint64_t collectorAllocations();
+uint64_t threadAllocations();
+
+// Scoped trace zones (zones.cpp): per-thread rings of the latest timed scopes,
+// dumped on demand as Chrome trace JSON
+uint64_t zoneClockNs();
+void nameZoneThread(const char *name);
+void recordZone(const char *name, uint64_t start_ns, uint64_t end_ns);
+bool dumpZoneTrace(const string &path);
+bool dumpZoneTraceNow(string &path); // monitor-zones-<unix ms>.json
+int droppedZoneThreads();
+
+// times the enclosing scope as one zone; name must outlive the program
+class ZoneScope
+{
+public:
+    explicit ZoneScope(const char *name) : name(name), start_ns(zoneClockNs()) {}
+    ~ZoneScope() { recordZone(name, start_ns, zoneClockNs()); }
+    ZoneScope(const ZoneScope &) = delete;
+    ZoneScope &operator=(const ZoneScope &) = delete;
+
+private:
+    const char *name;
+    uint64_t start_ns;
+};
+#define TRACE_ZONE_JOIN2(a, b) a##b
+#define TRACE_ZONE_JOIN(a, b) TRACE_ZONE_JOIN2(a, b)
+#define TRACE_ZONE(name) ZoneScope TRACE_ZONE_JOIN(trace_zone_, __LINE__)(name)
+
+// Command line options and start-up shared by the GUI and headless builds (options.cpp)
+extern bool headless_mode;
+extern string headless_output;
+extern int headless_interval_ms;
+void printUsage(const char *program);
+bool parseArguments(int argc, char **argv, int &exit_code);
+bool selectDataSource();
+void startCollection();
+void stopCollection();
+
+// Headless collector (headless.cpp): samples and prints snapshots until SIGINT/SIGTERM
+int runHeadless();
+
+#endif
@@ -0,0 +1,333 @@
+/**
+ * @file compress.cpp
+ * @brief Gorilla-style compression for metric time series
+ * @details Implements the encoding from Facebook's Gorilla TSDB paper,
+ *          adapted to millisecond timestamps and 32-bit floats:
+ *
+ *          Timestamps are stored as the delta of consecutive deltas. A
+ *          sampler running at a fixed rate produces mostly zeros and small
+ *          jitter:
+ *          - '0'                     delta-of-delta is 0
+ *          - '10'   + 7 bits         in [-64, 63]
+ *          - '110'  + 9 bits         in [-256, 255]
+ *          - '1110' + 12 bits        in [-2048, 2047]
+ *          - '1111' + 32 bits        anything else
+ *
+ *          Values are XORed with the previous value. Slowly changing metrics
+ *          share sign, exponent and high mantissa bits, so the XOR is short:
+ *          - '0'                     same value
+ *          - '10' + meaningful bits  fits in the previous leading/trailing window
+ *          - '11' + 5 bits leading zeros + 5 bits (length - 1) + meaningful bits
+ *
+ *          Samples are grouped into blocks of BLOCK_SAMPLES. The first sample
+ *          of a block is stored verbatim, so every block decodes on its own.
+ * @author Stephen Kisengese
+ * @date 2025
+ */
+
+#include "collector.h"
+
+// =============================================================================
+// BIT STREAMS
+// =============================================================================
+
+/**
+ * @brief Appends the low @p bits bits of @p value, most significant first
+ */
+static void writeBits(vector<uint8_t> &buf, size_t &bit_count, uint64_t value, int bits)
+{
+    while (bits > 0)
+    {
+        int used = bit_count & 7;
+        if (used == 0)
+            buf.push_back(0);
+
+        int space = 8 - used;
+        int take = min(space, bits);
+        uint8_t chunk = (value >> (bits - take)) & ((1u << take) - 1);
+        buf.back() |= chunk << (space - take);
+        bits -= take;
+        bit_count += take;
+    }
+}
+
+/**
+ * @brief Sequential reader over a block's bit stream
+ * @details Reads up to 57 bits at a time from an unaligned 64-bit window,
+ *          which keeps decoding to a handful of instructions per field.
+ */
+struct BitReader
+{
+    const uint8_t *data;
+    size_t size; ///< bytes in data
+    size_t pos;  ///< bit position
+
+    uint64_t window() const
+    {
+        size_t byte = pos >> 3;
+        uint64_t word = 0;
+        if (byte + 8 <= size)
+        {
+            memcpy(&word, data + byte, 8);
+            word = __builtin_bswap64(word); // stream is most significant bit first
+        }
+        else
+        {
+            for (int i = 0; i < 8; i++)
+                word = (word << 8) | (byte + i < size ? data[byte + i] : 0);
+        }
+        return word << (pos & 7);
+    }
+
+    uint64_t read(int bits)
+    {
+        uint64_t value = window() >> (64 - bits);
+        pos += bits;
+        return value;
+    }
+
+    /**
+     * @brief Counts leading 1 bits of a prefix code, consuming at most @p max
+     *        ones and the terminating 0
+     */
+    int readPrefix(int max)
+    {
+        uint64_t word = window();
+        int ones = __builtin_clzll(~word | (1ULL << (63 - max)));
+        ones = min(ones, max);
+        pos += ones + (ones < max ? 1 : 0);
+        return ones;
+    }
+};
+
+static int64_t signExtend(uint64_t value, int bits)
+{
+    uint64_t sign = 1ULL << (bits - 1);
+    return (int64_t)((value ^ sign) - sign);
+}
+
+static uint32_t floatBits(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static float bitsFloat(uint32_t bits)
+{
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// =============================================================================
+// COMPRESSED SERIES
+// =============================================================================
+
+/**
+ * @brief Creates an empty series that keeps samples for @p retention
+ * @details Retention is applied per sealed block, so up to one extra block
+ *          of older samples may be kept.
+ */
+CompressedSeries::CompressedSeries(chrono::milliseconds retention) : retention(retention)
+{
+}
+
+/**
+ * @brief Appends one sample; timestamps must not decrease
+ */
+void CompressedSeries::append(int64_t time_ms, float value)
+{
+    // A gap too long for a 32-bit delta-of-delta starts a fresh block
+    if (open.count > 0)
+    {
+        int64_t dod = (time_ms - open.last_time) - open.prev_delta;
+        if (dod < INT32_MIN || dod > INT32_MAX)
+            sealOpenBlock();
+    }
+
+    Block &block = open;
+    uint32_t bits = floatBits(value);
+
+    if (block.count == 0)
+    {
+        writeBits(block.bits, block.bit_count, (uint64_t)time_ms, 64);
+        writeBits(block.bits, block.bit_count, bits, 32);
+        block.first_time = time_ms;
+        block.prev_delta = 0;
+        block.prev_leading = -1;
+    }
+    else
+    {
+        // Timestamp: delta of deltas
+        int64_t delta = time_ms - block.last_time;
+        int64_t dod = delta - block.prev_delta;
+        if (dod == 0)
+            writeBits(block.bits, block.bit_count, 0x0, 1);
+        else if (dod >= -64 && dod <= 63)
+        {
+            writeBits(block.bits, block.bit_count, 0x2, 2);
+            writeBits(block.bits, block.bit_count, (uint64_t)dod, 7);
+        }
+        else if (dod >= -256 && dod <= 255)
+        {
+            writeBits(block.bits, block.bit_count, 0x6, 3);
+            writeBits(block.bits, block.bit_count, (uint64_t)dod, 9);
+        }
+        else if (dod >= -2048 && dod <= 2047)
+        {
+            writeBits(block.bits, block.bit_count, 0xE, 4);
+            writeBits(block.bits, block.bit_count, (uint64_t)dod, 12);
+        }
+        else
+        {
+            writeBits(block.bits, block.bit_count, 0xF, 4);
+            writeBits(block.bits, block.bit_count, (uint64_t)dod, 32);
+        }
+        block.prev_delta = delta;
+
+        // Value: XOR with the previous one
+        uint32_t x = bits ^ block.prev_value;
+        if (x == 0)
+        {
+            writeBits(block.bits, block.bit_count, 0x0, 1);
+        }
+        else
+        {
+            int leading = min(__builtin_clz(x), 31);
+            int trailing = __builtin_ctz(x);
+
+            if (block.prev_leading >= 0 && leading >= block.prev_leading && trailing >= block.prev_trailing)
+            {
+                int length = 32 - block.prev_leading - block.prev_trailing;
+                writeBits(block.bits, block.bit_count, 0x2, 2);
+                writeBits(block.bits, block.bit_count, x >> block.prev_trailing, length);
+            }
+            else
+            {
+                int length = 32 - leading - trailing;
+                writeBits(block.bits, block.bit_count, 0x3, 2);
+                writeBits(block.bits, block.bit_count, leading, 5);
+                writeBits(block.bits, block.bit_count, length - 1, 5);
+                writeBits(block.bits, block.bit_count, x >> trailing, length);
+                block.prev_leading = leading;
+                block.prev_trailing = trailing;
+            }
+        }
+    }
+
+    block.prev_value = bits;
+    block.last_time = time_ms;
+    block.count++;
+
+    if (block.count == BLOCK_SAMPLES)
+        sealOpenBlock();
+
+    // Drop sealed blocks that ended before the retention window
+    while (!sealed.empty() && sealed.front()->last_time < time_ms - retention.count())
+    {
+        sealed.pop_front();
+    }
+}
+
+/**
+ * @brief Moves the open block to the shared, immutable sealed list
+ */
+void CompressedSeries::sealOpenBlock()
+{
+    open.bits.shrink_to_fit();
+    sealed.push_back(make_shared<const Block>(move(open)));
+    open = Block();
+}
+
+size_t CompressedSeries::size() const
+{
+    size_t count = open.count;
+    for (const auto &block : sealed)
+        count += block->count;
+    return count;
+}
+
+size_t CompressedSeries::bytes() const
+{
+    size_t total = open.bits.size();
+    for (const auto &block : sealed)
+        total += block->bits.size();
+    return total;
+}
+
+/**
+ * @brief Appends the samples of one block to @p values (and @p times)
+ */
+void CompressedSeries::decodeBlock(const Block &block, vector<float> &values, vector<int64_t> *times)
+{
+    if (block.count == 0)
+        return;
+
+    BitReader reader = {block.bits.data(), block.bits.size(), 0};
+    int64_t time = (int64_t)reader.read(64);
+    uint32_t value = (uint32_t)reader.read(32);
+    int64_t delta = 0;
+    int leading = 0;
+    int trailing = 0;
+
+    values.push_back(bitsFloat(value));
+    if (times)
+        times->push_back(time);
+
+    for (uint32_t i = 1; i < block.count; i++)
+    {
+        switch (reader.readPrefix(4))
+        {
+        case 0:
+            break;
+        case 1:
+            delta += signExtend(reader.read(7), 7);
+            break;
+        case 2:
+            delta += signExtend(reader.read(9), 9);
+            break;
+        case 3:
+            delta += signExtend(reader.read(12), 12);
+            break;
+        default:
+            delta += signExtend(reader.read(32), 32);
+            break;
+        }
+        time += delta;
+
+        if (reader.read(1))
+        {
+            if (reader.read(1))
+            {
+                leading = (int)reader.read(5);
+                int length = (int)reader.read(5) + 1;
+                trailing = 32 - leading - length;
+            }
+            int length = 32 - leading - trailing;
+            value ^= (uint32_t)reader.read(length) << trailing;
+        }
+
+        values.push_back(bitsFloat(value));
+        if (times)
+            times->push_back(time);
+    }
+}
+
+/**
+ * @brief Decodes every retained sample, oldest first
+ * @param values Receives the values (cleared first)
+ * @param times Optional; receives the matching millisecond timestamps
+ * @return Number of samples decoded
+ */
+size_t CompressedSeries::decode(vector<float> &values, vector<int64_t> *times) const
+{
+    values.clear();
+    if (times)
+        times->clear();
+
+    for (const auto &block : sealed)
+        decodeBlock(*block, values, times);
+    decodeBlock(open, values, times);
+    return values.size();
+}
@@ -0,0 +1,155 @@
+/**
+ * @file headless.cpp
+ * @brief Headless collector: the sampler without a window
+ * @details `monitor --headless` (or the `monitor-headless` build, which links
+ *          no ImGui, SDL or OpenGL code at all) runs the same collectors as
+ *          the GUI and prints one compact snapshot line per interval, to
+ *          stdout or appended to --output PATH:
+ *
+ * @code
+ *   t=1760601600123 cpu=12.5 temp=48.0 fan=2100 mem=4123451392/16624123904
+ *   swap=0/2147479552 disk=81234567168/250790436864 procs=312 run=2 zombie=0
+ *   rx=1234567890 tx=98765432 top=4242/firefox/35.2
+ * @endcode
+ *
+ *          (one line per snapshot; wrapped here for width). Sizes are bytes,
+ *          rx/tx are totals over every interface except lo since boot, and
+ *          `-` marks a sensor that is not available. Whitespace in the top
+ *          process name is replaced by '_' so every field stays one token.
+ *
+ *          CPU, thermal and fan sampling is slowed to the output interval
+ *          (the GUI samples them at the graph FPS), so an idle headless
+ *          collector wakes about once per interval.
+ * @author Stephen Kisengese
+ * @date 2025
+ */
+
+#include "collector.h"
+#include <signal.h>
+
+// =============================================================================
+// SNAPSHOT LINE
+// =============================================================================
+
+/**
+ * @brief Appends one snapshot line built from the published collector data
+ */
+static void writeSnapshot(FILE *out)
+{
+    const MemoryInfo &memory = getCachedMemoryInfo();
+    shared_ptr<const ProcessSnapshot> snapshot = getProcessSnapshot();
+    const NetworkSnapshot &network = getNetworkSnapshot();
+
+    long long now_ms = chrono::duration_cast<chrono::milliseconds>(
+                           chrono::system_clock::now().time_since_epoch())
+                           .count();
+
+    char temperature[16] = "-";
+    if (thermal_available.load())
+        snprintf(temperature, sizeof(temperature), "%.1f", current_temperature.load());
+    char fan[16] = "-";
+    if (fan_available.load())
+        snprintf(fan, sizeof(fan), "%d", current_fan_speed.load());
+
+    unsigned long long rx = 0, tx = 0;
+    for (const auto &pair : network.rx)
+    {
+        if (pair.first != "lo")
+            rx += pair.second.bytes;
+    }
+    for (const auto &pair : network.tx)
+    {
+        if (pair.first != "lo")
+            tx += pair.second.bytes;
+    }
+
+    // Busiest process of the last scan
+    const Proc *top = nullptr;
+    for (const Proc &proc : snapshot->processes)
+    {
+        if (top == nullptr || proc.cpu_percent > top->cpu_percent)
+            top = &proc;
+    }
+    string top_name = top != nullptr ? top->name : "-";
+    replace_if(top_name.begin(), top_name.end(), [](char c)
+               { return isspace((unsigned char)c) != 0; }, '_');
+
+    fprintf(out, "t=%lld cpu=%.1f temp=%s fan=%s mem=%lu/%lu swap=%lu/%lu disk=%lu/%lu "
+                 "procs=%d run=%d zombie=%d rx=%llu tx=%llu top=%d/%s/%.1f\n",
+            now_ms, current_cpu_usage.load(), temperature, fan,
+            memory.used_ram, memory.total_ram, memory.used_swap, memory.total_swap,
+            memory.used_disk, memory.total_disk,
+            snapshot->counts.total, snapshot->counts.running, snapshot->counts.zombie,
+            rx, tx, top != nullptr ? top->pid : 0, top_name.c_str(),
+            top != nullptr ? top->cpu_percent : 0.0f);
+    fflush(out);
+}
+
+// =============================================================================
+// MAIN LOOP
+// =============================================================================
+
+/**
+ * @brief Runs the collectors and prints a snapshot every headless_interval_ms
+ * @return Process exit status
+ *
+ * SIGINT and SIGTERM are blocked before the sampler starts, so every thread
+ * inherits the mask and the main thread receives them through sigtimedwait(),
+ * which doubles as the interval timer. On either signal the sampler is
+ * stopped cleanly, so the metric store and trace are closed properly.
+ * SIGUSR1 dumps the trace zones (zones.cpp) to the working directory.
+ */
+int runHeadless()
+{
+    FILE *out = stdout;
+    if (!headless_output.empty())
+    {
+        out = fopen(headless_output.c_str(), "ae");
+        if (out == nullptr)
+        {
+            fprintf(stderr, "Cannot open %s: %s\n", headless_output.c_str(), strerror(errno));
+            return 1;
+        }
+    }
+
+    // Sample the graph metrics once per snapshot instead of at the graph FPS
+    float rate = min(30.0f, max(1.0f, 1000.0f / headless_interval_ms));
+    graph_fps.store(rate);
+    thermal_fps.store(rate);
+    fan_fps.store(rate);
+
+    nameZoneThread("main");
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    sigaddset(&signals, SIGUSR1);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    startCollection();
+
+    timespec interval;
+    interval.tv_sec = headless_interval_ms / 1000;
+    interval.tv_nsec = (headless_interval_ms % 1000) * 1000000L;
+    while (true)
+    {
+        int signal = sigtimedwait(&signals, nullptr, &interval);
+        if (signal == SIGINT || signal == SIGTERM)
+            break;
+        if (signal == SIGUSR1)
+        {
+            string path;
+            if (dumpZoneTraceNow(path))
+                fprintf(stderr, "Wrote trace zones to %s\n", path.c_str());
+            else
+                fprintf(stderr, "Cannot write %s: %s\n", path.c_str(), strerror(errno));
+            continue;
+        }
+        writeSnapshot(out);
+    }
+
+    stopCollection();
+    if (out != stdout)
+        fclose(out);
+    return 0;
+}
@@ -0,0 +1,26 @@
+/**
+ * @file headless_main.cpp
+ * @brief Entry point of the `monitor-headless` build (make headless)
+ * @details Same collectors and options as `monitor --headless`, linked without
+ *          ImGui, SDL or OpenGL so it runs on servers with no display stack.
+ * @author Stephen Kisengese
+ * @date 2025
+ */
+
+#include "collector.h"
+
+int main(int argc, char **argv)
+{
+    headless_mode = true;
+
+    int exit_code = 0;
+    if (!parseArguments(argc, argv, exit_code))
+    {
+        return exit_code;
+    }
+    if (!selectDataSource())
+    {
+        return 1;
+    }
+    return runHeadless();
+}
@@ -0,0 +1,141 @@
+/**
+ * @file history.cpp
+ * @brief Multi-resolution rollup histories
+ * @details Each metric keeps its last HISTORY_DEPTH raw samples plus three
+ *          rollup tiers (10 s, 1 min, 1 h buckets) holding min/max/avg. All
+ *          tiers are fixed-size rings fed from the same samples, so the graphs
+ *          can zoom from the last few seconds out to 24 hours and beyond
+ *          without any extra sampling and without memory growing over time.
+ *          The last hour is also kept at full resolution in a compressed
+ *          series (see compress.cpp). The graph window selector that plots
+ *          these histories lives in history_ui.cpp.
+ * @author Stephen Kisengese
+ * @date 2025
+ */
+
+#include "collector.h"
+
+// =============================================================================
+// ROLLUP HISTORY
+// =============================================================================
+
+// Offset from steady_clock time to the history timeline. Samples replayed
+// from the store can be up to a week older than boot (the steady_clock
+// epoch); 8 days keeps every timeline point non-negative, and a whole number
+// of hours keeps the buckets aligned as on the steady clock.
+static const chrono::hours timeline_offset(24 * 8);
+
+/**
+ * @brief Number of the @p width bucket holding @p time, rounded down
+ */
+static long long bucketIndex(chrono::steady_clock::duration time, chrono::seconds width)
+{
+    long long index = time / width;
+    if (time % width < chrono::steady_clock::duration::zero())
+        index--; // division truncates toward zero; buckets before 0 need floor
+    return index;
+}
+
+/**
+ * @brief Width of one bucket in @p tier
+ */
+chrono::seconds RollupHistory::bucketWidth(RollupTier tier)
+{
+    switch (tier)
+    {
+    case ROLLUP_10S:
+        return chrono::seconds(10);
+    case ROLLUP_1M:
+        return chrono::minutes(1);
+    default:
+        return chrono::hours(1);
+    }
+}
+
+/**
+ * @brief Folds one sample into a tier's open bucket
+ * @details When the sample belongs to a later bucket than the open one, the
+ *          open bucket is closed into the ring first. Buckets with no samples
+ *          (e.g. while the graph was paused) are not stored.
+ */
+template <size_t N>
+void RollupHistory::addToTier(RingBuffer<RollupBucket, N> &closed, OpenBucket &open, float value, long long index)
+{
+    if (open.index != index)
+    {
+        if (open.bucket.count > 0)
+        {
+            closed.push(open.bucket);
+        }
+        open.index = index;
+        open.bucket = {value, value, 0.0f, 0};
+    }
+
+    RollupBucket &bucket = open.bucket;
+    bucket.min = min(bucket.min, value);
+    bucket.max = max(bucket.max, value);
+    bucket.count++;
+    bucket.avg += (value - bucket.avg) / bucket.count; // running mean
+}
+
+/**
+ * @brief Records one sample in the raw ring and every rollup tier
+ * @param value Sample value
+ * @param now Time the sample was taken; buckets are aligned on this clock
+ */
+void RollupHistory::push(float value, chrono::steady_clock::time_point now)
+{
+    raw_samples.push(value);
+
+    chrono::steady_clock::duration timeline = now.time_since_epoch() + timeline_offset;
+    full_resolution.append(chrono::duration_cast<chrono::milliseconds>(timeline).count(), value);
+    addToTier(ten_seconds, open[ROLLUP_10S], value, bucketIndex(timeline, bucketWidth(ROLLUP_10S)));
+    addToTier(minutes, open[ROLLUP_1M], value, bucketIndex(timeline, bucketWidth(ROLLUP_1M)));
+    addToTier(hours, open[ROLLUP_1H], value, bucketIndex(timeline, bucketWidth(ROLLUP_1H)));
+}
+
+/**
+ * @brief Number of buckets in @p tier, including the one still filling
+ */
+size_t RollupHistory::bucketCount(RollupTier tier) const
+{
+    size_t open_count = open[tier].bucket.count > 0 ? 1 : 0;
+    switch (tier)
+    {
+    case ROLLUP_10S:
+        return ten_seconds.size() + open_count;
+    case ROLLUP_1M:
+        return minutes.size() + open_count;
+    default:
+        return hours.size() + open_count;
+    }
+}
+
+/**
+ * @brief Bucket @p index of @p tier, counted from the oldest
+ * @details The last index is the open bucket, so the newest data shows up
+ *          immediately instead of after the bucket closes.
+ */
+RollupBucket RollupHistory::bucket(RollupTier tier, size_t index) const
+{
+    size_t closed_count;
+    switch (tier)
+    {
+    case ROLLUP_10S:
+        closed_count = ten_seconds.size();
+        if (index < closed_count)
+            return ten_seconds[index];
+        break;
+    case ROLLUP_1M:
+        closed_count = minutes.size();
+        if (index < closed_count)
+            return minutes[index];
+        break;
+    default:
+        closed_count = hours.size();
+        if (index < closed_count)
+            return hours[index];
+        break;
+    }
+    return open[tier].bucket;
+}
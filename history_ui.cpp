@@ -0,0 +1,162 @@
+/**
+ * @file history_ui.cpp
+ * @brief Graph window selector for the rollup histories
+ * @details Lets every graph switch between raw samples, the full-resolution
+ *          hour and the 10 s / 1 min / 1 h rollup tiers kept by history.cpp,
+ *          and plots the selected window without copying the history.
+ * @author Stephen Kisengese
+ * @date 2025
+ */
+
+#include "header.h"
+
+// =============================================================================
+// GRAPH WINDOWS
+// =============================================================================
+
+/**
+ * @brief One entry of the graph window selector
+ */
+struct HistoryWindow
+{
+    const char *label; ///< Text shown in the combo box
+    int tier;          ///< RollupTier to plot, -1 for raw samples, -2 for the compressed full-resolution hour
+    size_t buckets;    ///< Number of most recent buckets shown
+};
+
+/**
+ * @brief Selectable graph windows, from raw samples to a week
+ * @details Bucket counts keep every window at a few hundred points at most,
+ *          so PlotLines cost does not depend on how far out the user zooms.
+ */
+static const HistoryWindow history_windows[] = {
+    {"Raw samples", -1, HISTORY_DEPTH},
+    {"1 hour (every sample)", -2, 0},
+    {"10 minutes", ROLLUP_10S, 60},
+    {"1 hour", ROLLUP_10S, 360},
+    {"6 hours", ROLLUP_1M, 360},
+    {"24 hours", ROLLUP_1M, 1440},
+    {"7 days", ROLLUP_1H, 168},
+};
+
+int historyWindowCount()
+{
+    return IM_ARRAYSIZE(history_windows);
+}
+
+/**
+ * @brief Combo box selecting which history window a graph shows
+ * @param id ImGui identifier (use a "##" prefix to hide the label)
+ * @param window Index into the window table, updated on selection
+ * @return true if the selection changed this frame
+ */
+bool renderHistoryWindowCombo(const char *id, int &window)
+{
+    window = max(0, min(window, historyWindowCount() - 1));
+
+    bool changed = false;
+    if (ImGui::BeginCombo(id, history_windows[window].label))
+    {
+        for (int i = 0; i < historyWindowCount(); i++)
+        {
+            bool selected = i == window;
+            if (ImGui::Selectable(history_windows[i].label, selected))
+            {
+                window = i;
+                changed = true;
+            }
+            if (selected)
+                ImGui::SetItemDefaultFocus();
+        }
+        ImGui::EndCombo();
+    }
+    return changed;
+}
+
+/**
+ * @brief Getter state for plotting a range of rollup buckets in place
+ */
+struct RollupPlotSource
+{
+    const RollupHistory *history;
+    RollupTier tier;
+    size_t first; ///< Index of the oldest bucket shown
+};
+
+static float bucketAvg(void *data, int idx)
+{
+    const RollupPlotSource *source = static_cast<const RollupPlotSource *>(data);
+    return source->history->bucket(source->tier, source->first + idx).avg;
+}
+
+static float bucketMin(void *data, int idx)
+{
+    const RollupPlotSource *source = static_cast<const RollupPlotSource *>(data);
+    return source->history->bucket(source->tier, source->first + idx).min;
+}
+
+static float bucketMax(void *data, int idx)
+{
+    const RollupPlotSource *source = static_cast<const RollupPlotSource *>(data);
+    return source->history->bucket(source->tier, source->first + idx).max;
+}
+
+/**
+ * @brief Plots @p history over the selected window
+ * @param id ImGui identifier of the plot
+ * @param history Rollup history published by the sampler
+ * @param window Index into the window table
+ * @param scale_max Upper bound of the Y axis (the lower bound is 0)
+ * @param size Plot size
+ * @return Number of points plotted
+ *
+ * Raw samples are plotted straight from the ring. The full-resolution hour
+ * is decoded from its compressed blocks into a reused scratch buffer each
+ * frame (about 0.7 ms for 36k samples, see bench_gorilla). Rollup windows plot the
+ * bucket averages, with the per-bucket min and max drawn as faint lines on
+ * top so short spikes stay visible when zoomed out.
+ */
+size_t renderHistoryPlot(const char *id, const RollupHistory &history, int window,
+                         float scale_max, ImVec2 size)
+{
+    const HistoryWindow &selected = history_windows[max(0, min(window, historyWindowCount() - 1))];
+
+    if (selected.tier < 0)
+    {
+        const MetricHistory &raw = history.raw();
+        ImGui::PlotLines(id, raw.data(), (int)raw.size(), (int)raw.offset(),
+                         nullptr, 0.0f, scale_max, size);
+        return raw.size();
+    }
+
+    if (selected.tier == -2)
+    {
+        static vector<float> decoded; // render thread only; keeps its capacity between frames
+        size_t count = history.fullResolution().decode(decoded);
+        ImGui::PlotLines(id, decoded.data(), (int)count, 0, nullptr, 0.0f, scale_max, size);
+        return count;
+    }
+
+    RollupTier tier = static_cast<RollupTier>(selected.tier);
+    size_t available = history.bucketCount(tier);
+    size_t shown = min(available, selected.buckets);
+    RollupPlotSource source = {&history, tier, available - shown};
+
+    ImVec2 plot_pos = ImGui::GetCursorScreenPos();
+    ImGui::PlotLines(id, bucketAvg, &source, (int)shown, 0, nullptr, 0.0f, scale_max, size);
+    ImVec2 next_pos = ImGui::GetCursorScreenPos();
+
+    // Min/max envelope over the average, on a transparent frame
+    ImGui::PushID(id);
+    ImGui::PushStyleColor(ImGuiCol_FrameBg, IM_COL32(0, 0, 0, 0));
+    ImGui::PushStyleColor(ImGuiCol_PlotLines, IM_COL32(255, 255, 255, 60));
+    ImGui::SetCursorScreenPos(plot_pos);
+    ImGui::PlotLines("##max", bucketMax, &source, (int)shown, 0, nullptr, 0.0f, scale_max, size);
+    ImGui::SetCursorScreenPos(plot_pos);
+    ImGui::PlotLines("##min", bucketMin, &source, (int)shown, 0, nullptr, 0.0f, scale_max, size);
+    ImGui::PopStyleColor(2);
+    ImGui::PopID();
+    ImGui::SetCursorScreenPos(next_pos);
+
+    return shown;
+}
@@ -44,21 +44,12 @@ using namespace gl;
 // systemWindow, display information for the system monitorization
 void systemWindow(const char *id, ImVec2 size, ImVec2 position)
 {
-    static SystemInfo sysInfo;
-    static auto last_info_update = chrono::steady_clock::now();
+    const SystemInfo &sysInfo = getCachedSystemInfo(); // published by the sampler thread
 
     ImGui::Begin(id);
     ImGui::SetWindowSize(id, size);
     ImGui::SetWindowPos(id, position);
 
-    auto now = chrono::steady_clock::now();
-    auto elapsed = chrono::duration_cast<chrono::milliseconds>(now - last_info_update);
-    if (elapsed.count() > 2000) // Refresh every 2 seconds
-    {
-        sysInfo = getSystemInfo(); // fetch fresh data from /proc
-        last_info_update = now;
-    }
-
     // Display system information 
     ImGui::PushStyleColor(ImGuiCol_Text, IM_COL32(100, 255, 100, 255)); // Light green for headers
     ImGui::Text("System Information");
@@ -80,26 +71,46 @@ void systemWindow(const char *id, ImVec2 size, ImVec2 position)
                 sysInfo.sleeping_processes, sysInfo.zombie_processes,
                 sysInfo.stopped_processes);
 
+    shared_ptr<const ProcessSnapshot> snapshot = getProcessSnapshot();
+    if (snapshot->events_active)
+    {
+        ImGui::Text("Events: %d forks, %d execs, %d exits, %d short-lived",
+                    snapshot->events.forks, snapshot->events.execs,
+                    snapshot->events.exits, snapshot->events.short_lived);
+        if (!snapshot->short_lived.empty() && ImGui::IsItemHovered())
+        {
+            ImGui::BeginTooltip();
+            for (const string &name : snapshot->short_lived)
+                ImGui::TextUnformatted(name.c_str());
+            ImGui::EndTooltip();
+        }
+    }
+    else
+    {
+        ImGui::TextDisabled("Events: unavailable (polling /proc)");
+    }
+
+    if (metricsServerActive())
+    {
+        ImGui::Text("Metrics: http://127.0.0.1:%d/metrics (%llu scrapes)", metrics_port,
+                    (unsigned long long)metricsScrapeCount());
+    }
+    if (traceRecorderActive())
+    {
+        ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "Recording sources: %s written",
+                           formatBytes(traceRecorderBytes()).c_str());
+    }
+
     ImGui::Spacing();
     ImGui::Separator();
 
     // Tabbed interface for performance monitoring 
     if (ImGui::BeginTabBar("PerformanceMonitor"))
     {
-        static auto last_update = now;
         ImGui::PushStyleColor(ImGuiCol_Text, IM_COL32(255, 150, 150, 255));
         if (ImGui::BeginTabItem("CPU")) // CPU Tab
         {
             ImGui::PopStyleColor();
-            // Update CPU data based on FPS setting
-            auto now = chrono::steady_clock::now();
-            auto elapsed = chrono::duration_cast<chrono::milliseconds>(now - last_update);
-            if (!graph_paused && elapsed.count() >= (1000.0f / graph_fps))
-            {
-                updateCPUHistory();
-                last_update = now;
-            }
-
             renderCPUGraph();
             ImGui::EndTabItem();
         }
@@ -113,14 +124,6 @@ void systemWindow(const char *id, ImVec2 size, ImVec2 position)
         if (ImGui::BeginTabItem("Fan")) // Fan Tab
         {
             ImGui::PopStyleColor();
-            auto now = chrono::steady_clock::now();
-            auto elapsed = chrono::duration_cast<chrono::milliseconds>(now - last_update);
-            if (!fan_paused && elapsed.count() >= (1000.0f / fan_fps))
-            {
-                updateFanHistory();
-                last_update = now;
-            }
-
             renderFanGraph();
             ImGui::EndTabItem();
         }
@@ -134,14 +137,6 @@ void systemWindow(const char *id, ImVec2 size, ImVec2 position)
         if (ImGui::BeginTabItem("Thermal")) // Thermal Tab
         {
             ImGui::PopStyleColor();
-            auto now = chrono::steady_clock::now();
-            auto elapsed = chrono::duration_cast<chrono::milliseconds>(now - last_update);
-            if (!thermal_paused && elapsed.count() >= (1000.0f / thermal_fps))
-            {
-                updateThermalHistory();
-                last_update = now;
-            }
-
             renderThermalGraph();
             ImGui::EndTabItem();
         }
@@ -150,6 +145,19 @@ void systemWindow(const char *id, ImVec2 size, ImVec2 position)
             ImGui::PopStyleColor();
         }
 
+        // Monitor Overhead Tab: the monitor's own cost
+        ImGui::PushStyleColor(ImGuiCol_Text, IM_COL32(255, 220, 120, 255));
+        if (ImGui::BeginTabItem("Monitor Overhead"))
+        {
+            ImGui::PopStyleColor();
+            renderOverheadPanel();
+            ImGui::EndTabItem();
+        }
+        else
+        {
+            ImGui::PopStyleColor();
+        }
+
         ImGui::EndTabBar();
     }
 
@@ -163,19 +171,8 @@ void memoryProcessesWindow(const char *id, ImVec2 size, ImVec2 position)
     ImGui::SetWindowSize(id, size);
     ImGui::SetWindowPos(id, position);
 
-    static vector<Proc> cached_processes;
-    static chrono::steady_clock::time_point last_update;
-    static bool processes_need_update = true;
-
-    // Check if we need to update process list (every 3 seconds)
-    auto now = chrono::steady_clock::now();
-    if (processes_need_update ||
-        chrono::duration_cast<chrono::seconds>(now - last_update).count() >= 3)
-    {
-        cached_processes = getAllProcesses();
-        last_update = now;
-        processes_need_update = false;
-    }
+    // Process snapshot is rebuilt by the sampler thread every 3 seconds
+    shared_ptr<const ProcessSnapshot> snapshot = getProcessSnapshot();
 
     // Memory usage section
     if (ImGui::CollapsingHeader("Memory Usage", ImGuiTreeNodeFlags_DefaultOpen))
@@ -188,8 +185,7 @@ void memoryProcessesWindow(const char *id, ImVec2 size, ImVec2 position)
     // Process table section
     if (ImGui::CollapsingHeader("Process Table", ImGuiTreeNodeFlags_DefaultOpen))
     {
-        updateProcessCPUData();
-        renderProcessTable(cached_processes);
+        renderProcessTable(snapshot);
     }
 
     ImGui::End();
@@ -202,21 +198,6 @@ void networkWindow(const char *id, ImVec2 size, ImVec2 position)
     ImGui::SetWindowSize(id, size);
     ImGui::SetWindowPos(id, position);
 
-    // Update network data periodically
-    static auto last_update = chrono::steady_clock::now();
-    auto now = chrono::steady_clock::now();
-    auto elapsed = chrono::duration_cast<chrono::milliseconds>(now - last_update);
-
-    if (elapsed.count() > 2000)
-    { // Update every 2 seconds
-        thread([]()
-               {
-            parseNetworkDevFile();
-            getNetworkInterfaces(); })
-            .detach();
-        last_update = now;
-    }
-
     // Header section with network interfaces overview
     ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.4f, 0.8f, 1.0f, 1.0f));
     ImGui::Text("Network Interfaces");
@@ -339,15 +320,140 @@ void networkWindow(const char *id, ImVec2 size, ImVec2 position)
             ImGui::EndTabItem();
         }
 
+        // Throughput history tab (bytes/s over all interfaces)
+        if (ImGui::BeginTabItem("Throughput"))
+        {
+            ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.8f, 0.8f, 0.8f, 1.0f));
+            ImGui::Text("Bytes per second over all interfaces");
+            ImGui::PopStyleColor();
+            ImGui::Spacing();
+            renderThroughputGraphs();
+            ImGui::EndTabItem();
+        }
+
         ImGui::EndTabBar();
     }
 
     ImGui::End();
 }
 
+// =============================================================================
+// FRAME PACING
+// =============================================================================
+
+static const int input_settle_frames = 3;   ///< Frames drawn after input so hover, popups and scrolling catch up
+static const int unfocused_frame_ms = 250;  ///< Minimum gap between frames while the window has no focus
+static const int idle_frame_ms = 1000;      ///< Longest gap between frames of a visible window
+static const int text_input_frame_ms = 500; ///< Longest gap while a text field is active (cursor blink)
+
+static Uint32 sample_event_type = (Uint32)-1;    ///< SDL user event pushed when the sampler publishes
+static atomic<bool> sample_event_pending(false); ///< Keeps at most one sample event in the queue
+static atomic<bool> sample_wakeups(true);        ///< Cleared while minimized: nothing to redraw
+
+/**
+ * @brief Render loop state deciding when the next frame is due
+ */
+struct FramePacer
+{
+    int settle_frames = input_settle_frames; ///< Frames still to draw for recent input
+    bool new_data = true;                    ///< The sampler published since the last frame
+    chrono::steady_clock::time_point last_frame;
+};
+
+/**
+ * @brief Sample listener: wakes the render loop with an SDL user event
+ * @note Sampler thread; SDL_PushEvent() is thread-safe
+ */
+static void onSamplePublished()
+{
+    if (!sample_wakeups.load(memory_order_relaxed) || sample_event_pending.exchange(true))
+        return;
+
+    SDL_Event event;
+    SDL_zero(event);
+    event.type = sample_event_type;
+    SDL_PushEvent(&event);
+}
+
+/**
+ * @brief Passes one event to ImGui and notes whether it calls for a frame
+ */
+static void handleEvent(const SDL_Event &event, SDL_Window *window, FramePacer &pacer, bool &done)
+{
+    if (event.type == sample_event_type)
+    {
+        sample_event_pending.store(false);
+        pacer.new_data = true;
+        return;
+    }
+
+    ImGui_ImplSDL2_ProcessEvent(&event);
+    pacer.settle_frames = input_settle_frames;
+    if (event.type == SDL_QUIT)
+        done = true;
+    if (event.type == SDL_WINDOWEVENT && event.window.event == SDL_WINDOWEVENT_CLOSE && event.window.windowID == SDL_GetWindowID(window))
+        done = true;
+}
+
+/**
+ * @brief Sleeps in SDL_WaitEventTimeout() until the next frame is due
+ * @details A frame is due right away after input, when the sampler published
+ *          new data (at most every unfocused_frame_ms without focus), or when
+ *          idle_frame_ms passed without either. A minimized or hidden window
+ *          draws nothing and is not woken by the sampler until it is restored.
+ */
+static void waitForFrame(SDL_Window *window, FramePacer &pacer, bool &done)
+{
+    while (!done)
+    {
+        Uint32 flags = SDL_GetWindowFlags(window);
+        bool minimized = (flags & (SDL_WINDOW_MINIMIZED | SDL_WINDOW_HIDDEN)) != 0;
+        bool focused = (flags & SDL_WINDOW_INPUT_FOCUS) != 0;
+        sample_wakeups.store(!minimized);
+
+        int wait_ms = idle_frame_ms;
+        if (!minimized)
+        {
+            int since_ms = (int)chrono::duration_cast<chrono::milliseconds>(
+                               chrono::steady_clock::now() - pacer.last_frame)
+                               .count();
+            if (pacer.settle_frames > 0)
+                wait_ms = 0;
+            else if (pacer.new_data)
+                wait_ms = focused ? 0 : unfocused_frame_ms - since_ms;
+            else if (focused && ImGui::GetIO().WantTextInput)
+                wait_ms = text_input_frame_ms - since_ms;
+            else
+                wait_ms = idle_frame_ms - since_ms;
+
+            if (wait_ms <= 0)
+                return;
+        }
+
+        SDL_Event event;
+        if (SDL_WaitEventTimeout(&event, wait_ms))
+            handleEvent(event, window, pacer, done);
+    }
+}
+
 // Main code
-int main(int, char **)
+int main(int argc, char **argv)
 {
+    int exit_code = 0;
+    if (!parseArguments(argc, argv, exit_code))
+    {
+        return exit_code;
+    }
+    if (!selectDataSource())
+    {
+        return 1;
+    }
+    if (headless_mode)
+    {
+        // No window: sample and print snapshots without touching SDL or OpenGL
+        return runHeadless();
+    }
+
     // Setup SDL
     // (Some versions of SDL before <2.0.10 appears to have performance/stalling issues on a minority of Windows systems,
     // depending on whether SDL_INIT_GAMECONTROLLER is enabled or disabled.. updating to latest version of SDL is recommended!)
@@ -416,30 +522,52 @@ int main(int, char **)
     // note : you are free to change the style of the application
     ImVec4 clear_color = ImVec4(0.0f, 0.0f, 0.0f, 0.0f);
 
+    // The sampler wakes the render loop whenever it publishes new data
+    sample_event_type = SDL_RegisterEvents(1);
+    if (sample_event_type != (Uint32)-1)
+        setSampleListener(onSamplePublished);
+
+    // Collect system data on a background thread from now on
+    nameZoneThread("render");
+    startCollection();
+
     // Main loop
     bool done = false;
+    FramePacer pacer;
     while (!done)
     {
+        // Sleep until input, new samples or the idle deadline; without an
+        // SDL user event slot, fall back to drawing at the vsync rate
+        if (sample_event_type != (Uint32)-1)
+        {
+            waitForFrame(window, pacer, done);
+            if (done)
+                break;
+        }
+
         // Poll and handle events (inputs, window resize, etc.)
         // You can read the io.WantCaptureMouse, io.WantCaptureKeyboard flags to tell if dear imgui wants to use your inputs.
         // - When io.WantCaptureMouse is true, do not dispatch mouse input data to your main application.
         // - When io.WantCaptureKeyboard is true, do not dispatch keyboard input data to your main application.
         // Generally you may always pass all inputs to dear imgui, and hide them from your application based on those two flags.
+        beginFrameStage(FRAME_COLLECT);
         SDL_Event event;
         while (SDL_PollEvent(&event))
         {
-            ImGui_ImplSDL2_ProcessEvent(&event);
-            if (event.type == SDL_QUIT)
-                done = true;
-            if (event.type == SDL_WINDOWEVENT && event.window.event == SDL_WINDOWEVENT_CLOSE && event.window.windowID == SDL_GetWindowID(window))
-                done = true;
+            handleEvent(event, window, pacer, done);
         }
+        pacer.new_data = false;
+        pacer.last_frame = chrono::steady_clock::now();
+        if (pacer.settle_frames > 0)
+            pacer.settle_frames--;
 
         // Start the Dear ImGui frame
+        beginFrameStage(FRAME_NEW_FRAME);
         ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplSDL2_NewFrame(window);
         ImGui::NewFrame();
 
+        beginFrameStage(FRAME_VIEW_BUILD);
         {
             ImVec2 mainDisplay = io.DisplaySize;
             memoryProcessesWindow("== Memory and Processes ==",
@@ -456,15 +584,23 @@ int main(int, char **)
         }
 
         // Rendering
+        beginFrameStage(FRAME_RENDER);
         ImGui::Render();
         glViewport(0, 0, (int)io.DisplaySize.x, (int)io.DisplaySize.y);
         glClearColor(clear_color.x, clear_color.y, clear_color.z, clear_color.w);
         glClear(GL_COLOR_BUFFER_BIT);
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        {
+            TRACE_ZONE("ImGui_ImplOpenGL3_RenderDrawData");
+            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        }
+        beginFrameStage(FRAME_SWAP);
         SDL_GL_SwapWindow(window);
+        endFrame();
     }
 
     // Cleanup
+    stopCollection();
+    setSampleListener(nullptr);
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplSDL2_Shutdown();
     ImGui::DestroyContext();
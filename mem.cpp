@@ -1,52 +1,33 @@
 /**
  * @file mem.cpp
  * @brief System monitoring application with process management and memory tracking
- * @details This file implements a system monitor that displays real-time information about
- *          system memory (RAM, SWAP, disk usage) and running processes. It uses ImGui for
- *          the user interface and reads system information from /proc filesystem.
+ * @details This file collects real-time information about system memory
+ *          (RAM, SWAP, disk usage) and running processes from the /proc
+ *          filesystem, and publishes it to the render thread. The process
+ *          table and memory bars that display it live in mem_ui.cpp.
  * 
  * Features:
  * - Real-time memory usage monitoring (RAM, SWAP, disk)
  * - Process list with CPU and memory usage
- * - Process filtering and selection
- * - Sortable process table
- * - Color-coded usage indicators
+ * - Process filtering and sorting shared with the table
  * 
  * @author Stephen Kisengese
  * @version 1.0
  * @date 2025
  */
 
-#include "header.h"
-
-//=============================================================================
-// DATA STRUCTURES
-//=============================================================================
-
-/**
- * @struct ProcessCPUData
- * @brief Stores CPU usage tracking data for individual processes
- * @details This structure maintains historical CPU time data to calculate
- *          CPU usage percentage over time intervals.
- */
-struct ProcessCPUData
-{
-    long long prev_utime;                           ///< Previous user CPU time in ticks
-    long long prev_stime;                           ///< Previous system CPU time in ticks
-    float cpu_percent;                              ///< Calculated CPU usage percentage
-    chrono::steady_clock::time_point last_update;   ///< Timestamp of last update
-};
+#include "collector.h"
 
 //=============================================================================
 // GLOBAL VARIABLES
 //=============================================================================
 
-// Process selection and filtering
-static set<int> selected_pids;                     ///< Set of currently selected process IDs
-static char process_filter[256] = "";              ///< Process name filter string
-static map<int, ProcessCPUData> process_cpu_data;  ///< Map of PID to CPU usage data
-static chrono::steady_clock::time_point last_process_update; ///< Last process data update time
-static mutex process_cpu_mutex;                    ///< Mutex for thread-safe CPU data access
+// Sampler-owned data published to the render thread without locks
+static MemoryInfo sampled_memory;                   ///< Latest reading, sampler thread only
+static TripleBuffer<MemoryInfo> memory_info_buffer; ///< sampled_memory as published to the render thread
+static TripleBuffer<shared_ptr<const ProcessSnapshot>> snapshot_buffer; ///< Latest process scan
+static const shared_ptr<const ProcessSnapshot> empty_snapshot = make_shared<ProcessSnapshot>(); ///< Returned before the first scan
+static shared_ptr<const ProcessSnapshot> latest_snapshot = empty_snapshot; ///< Last published scan, sampler thread only
 
 //=============================================================================
 // MEMORY MONITORING FUNCTIONS
@@ -68,7 +49,9 @@ MemoryInfo getMemoryInfo()
     MemoryInfo info = {};
 
     // Parse /proc/meminfo for RAM and SWAP information
-    ifstream meminfo("/proc/meminfo");
+    string contents;
+    readSourceFile("/proc/meminfo", contents);
+    istringstream meminfo(contents);
     string line;
 
     while (getline(meminfo, line))
@@ -101,6 +84,7 @@ MemoryInfo getMemoryInfo()
 
     // Get disk usage using statvfs system call
     struct statvfs disk_info;
+    countCollectorIo(1);
     if (statvfs("/", &disk_info) == 0)
     {
         info.total_disk = disk_info.f_blocks * disk_info.f_frsize;
@@ -110,6 +94,36 @@ MemoryInfo getMemoryInfo()
     return info;
 }
 
+/**
+ * @brief Refreshes the cached memory information
+ * @details Called by the sampler thread so the render thread never reads
+ *          /proc/meminfo or calls statvfs() itself.
+ */
+void updateMemoryInfo()
+{
+    sampled_memory = getMemoryInfo();
+    memory_info_buffer.writeBuffer() = sampled_memory;
+    memory_info_buffer.publish();
+}
+
+/**
+ * @brief Returns the memory information read by the last updateMemoryInfo()
+ * @note Sampler thread only, like latestProcessSnapshot()
+ */
+const MemoryInfo &latestMemoryInfo()
+{
+    return sampled_memory;
+}
+
+/**
+ * @brief Returns the most recent memory information collected by the sampler
+ * @return Reference valid until the next call (render thread only)
+ */
+const MemoryInfo &getCachedMemoryInfo()
+{
+    return memory_info_buffer.read();
+}
+
 /**
  * @brief Calculates memory usage percentage
  * @param used Amount of memory used (in bytes)
@@ -163,296 +177,150 @@ string formatBytes(unsigned long bytes)
     return ss.str();
 }
 
-/**
- * @brief Determines color based on usage percentage
- * @param percentage Usage percentage (0.0 to 100.0)
- * @return ImVec4 color value for ImGui rendering
- * @details Color coding:
- *          - Green: < 70% usage (safe)
- *          - Yellow: 70-90% usage (warning)
- *          - Red: > 90% usage (critical)
- */
-ImVec4 getUsageColor(float percentage)
-{
-    if (percentage < 70.0f)
-    {
-        return ImVec4(0.0f, 0.8f, 0.0f, 1.0f); // Green
-    }
-    else if (percentage < 90.0f)
-    {
-        return ImVec4(1.0f, 1.0f, 0.0f, 1.0f); // Yellow
-    }
-    else
-    {
-        return ImVec4(1.0f, 0.0f, 0.0f, 1.0f); // Red
-    }
-}
+//=============================================================================
+// PROCESS MONITORING FUNCTIONS
+//=============================================================================
 
 /**
- * @brief Renders memory usage bars in the ImGui interface
- * @details Creates visual progress bars for RAM, SWAP, and disk usage
- *          with color-coded indicators and formatted text labels.
- *          Each bar shows percentage, used/total amounts, and visual indicator.
- * 
- * Layout:
- * - RAM Usage: Always displayed
- * - SWAP Usage: Only displayed if swap is available
- * - Disk Usage: Shows root filesystem usage
+ * @brief Share of @p interval_ns covered by the growth of a nanosecond total
+ * @details Totals of a thread group can shrink when a thread exits (its
+ *          share is dropped unless the kernel kept a per-group record), so
+ *          a decrease reads as 0% rather than wrapping around.
  */
-void renderMemoryBars()
+static float intervalPercent(unsigned long long now, unsigned long long then, double interval_ns)
 {
-    MemoryInfo mem_info = getMemoryInfo();
-
-    // RAM Usage Bar
-    float ram_percentage = calculateMemoryUsage(mem_info.used_ram, mem_info.total_ram);
-    ImGui::Text("RAM Usage:");
-    ImGui::SameLine();
-    ImGui::Text("%.1f%% (%s / %s)",
-                ram_percentage,
-                formatBytes(mem_info.used_ram).c_str(),
-                formatBytes(mem_info.total_ram).c_str());
-
-    ImGui::PushStyleColor(ImGuiCol_PlotHistogram, getUsageColor(ram_percentage));
-    ImGui::ProgressBar(ram_percentage / 100.0f, ImVec2(-1, 0));
-    ImGui::PopStyleColor();
-
-    ImGui::Separator();
-
-    // SWAP Usage Bar (only if swap is available)
-    if (mem_info.total_swap > 0)
-    {
-        float swap_percentage = calculateMemoryUsage(mem_info.used_swap, mem_info.total_swap);
-        ImGui::Text("SWAP Usage:");
-        ImGui::SameLine();
-        ImGui::Text("%.1f%% (%s / %s)",
-                    swap_percentage,
-                    formatBytes(mem_info.used_swap).c_str(),
-                    formatBytes(mem_info.total_swap).c_str());
-
-        ImGui::PushStyleColor(ImGuiCol_PlotHistogram, getUsageColor(swap_percentage));
-        ImGui::ProgressBar(swap_percentage / 100.0f, ImVec2(-1, 0));
-        ImGui::PopStyleColor();
-    }
-    else
-    {
-        ImGui::Text("SWAP Usage: Not available");
-        ImGui::ProgressBar(0.0f, ImVec2(-1, 0));
-    }
-
-    ImGui::Separator();
-
-    // Disk Usage Bar
-    float disk_percentage = calculateMemoryUsage(mem_info.used_disk, mem_info.total_disk);
-    ImGui::Text("Disk Usage (/):");
-    ImGui::SameLine();
-    ImGui::Text("%.1f%% (%s / %s)",
-                disk_percentage,
-                formatBytes(mem_info.used_disk).c_str(),
-                formatBytes(mem_info.total_disk).c_str());
-
-    ImGui::PushStyleColor(ImGuiCol_PlotHistogram, getUsageColor(disk_percentage));
-    ImGui::ProgressBar(disk_percentage / 100.0f, ImVec2(-1, 0));
-    ImGui::PopStyleColor();
+    if (now <= then || interval_ns <= 0.0)
+        return 0.0f;
+    return min((now - then) / interval_ns * 100.0, 100.0);
 }
 
-//=============================================================================
-// PROCESS MONITORING FUNCTIONS
-//=============================================================================
-
 /**
- * @brief Retrieves detailed information about a specific process
- * @param pid Process ID to query
- * @return Proc structure containing process information
- * @details Reads process information from /proc/[pid]/ filesystem:
- *          - /proc/[pid]/comm: Process name
- *          - /proc/[pid]/stat: Process statistics (CPU times, memory, state)
+ * @brief Fills in per-process CPU usage from the previous snapshot
+ * @param current Snapshot that was just scanned (processes sorted by PID)
+ * @param previous Snapshot from the previous sampler tick
+ * @details Both snapshots are sorted by PID, so matching processes are found
+ *          with a single merge walk instead of per-process map lookups.
  * 
- * Process state codes:
- * - R: Running
- * - S: Sleeping (interruptible)
- * - D: Disk sleep (uninterruptible)
- * - I: Idle
- * - Z: Zombie
- * - T: Stopped
+ * CPU Usage Calculation:
+ * - Uses the nanosecond taskstats run time when both snapshots have it,
+ *   otherwise the utime and stime ticks from /proc/[pid]/stat
+ * - Calculates difference from previous reading
+ * - Converts the difference to a percentage of the elapsed wall time
+ * - Processes not present in the previous snapshot start at 0%
+ *
+ * Run and I/O delay percentages are derived the same way from the
+ * taskstats delay totals, and stay 0 without taskstats.
  */
-Proc getProcessInfo(int pid)
+void updateProcessCPUData(ProcessSnapshot &current, const ProcessSnapshot &previous)
 {
-    Proc proc = {};
-    proc.pid = pid;
+    TRACE_ZONE("updateProcessCPUData");
+    auto time_diff = chrono::duration_cast<chrono::milliseconds>(current.taken_at - previous.taken_at);
+    double time_sec = time_diff.count() / 1000.0;
+    double ticks_per_sec = sysconf(_SC_CLK_TCK);
 
-    // Read process name from /proc/[pid]/comm
-    string comm_path = "/proc/" + to_string(pid) + "/comm";
-    ifstream comm_file(comm_path);
-    if (comm_file.is_open())
+    auto prev_it = previous.processes.begin();
+    for (Proc &proc : current.processes)
     {
-        getline(comm_file, proc.name);
-        // Remove trailing newline if present
-        if (!proc.name.empty() && proc.name.back() == '\n')
+        proc.cpu_percent = 0.0f;
+        proc.run_delay_percent = 0.0f;
+        proc.io_delay_percent = 0.0f;
+
+        while (prev_it != previous.processes.end() && prev_it->pid < proc.pid)
         {
-            proc.name.pop_back();
+            ++prev_it;
+        }
+        if (prev_it == previous.processes.end() || prev_it->pid != proc.pid || time_sec <= 0.0)
+        {
+            continue; // First time seeing this process
         }
-    }
-
-    // Read process statistics from /proc/[pid]/stat
-    string stat_path = "/proc/" + to_string(pid) + "/stat";
-    ifstream stat_file(stat_path);
-    if (stat_file.is_open())
-    {
-        string line;
-        getline(stat_file, line);
 
-        // Parse the stat line - format: pid (comm) state ppid ...
-        // Process name in parentheses may contain spaces, so we need careful parsing
-        size_t first_paren = line.find('(');
-        size_t last_paren = line.rfind(')');
+        if (prev_it->starttime != proc.starttime)
+        {
+            continue; // PID was reused by a new process
+        }
 
-        if (first_paren != string::npos && last_paren != string::npos && last_paren > first_paren)
+        if (proc.has_taskstats && prev_it->has_taskstats)
         {
-            // Extract PID (before first parenthesis)
-            string pid_str = line.substr(0, first_paren);
-            proc.pid = stoi(pid_str);
-
-            // Extract process name (between parentheses) - this might be truncated
-            string full_name = line.substr(first_paren + 1, last_paren - first_paren - 1);
-            if (proc.name.empty())
-            {
-                proc.name = full_name;
-            }
-
-            // Extract remaining fields after last parenthesis
-            string remaining = line.substr(last_paren + 1);
-            istringstream iss(remaining);
-            vector<string> fields;
-            string field;
-
-            while (iss >> field)
-            {
-                fields.push_back(field);
-            }
-
-            // Map fields according to /proc/[pid]/stat format
-            if (fields.size() >= 22)
-            {
-                proc.state = fields[0][0];      // State (field 3)
-                proc.utime = stoll(fields[11]); // User CPU time in ticks (field 14)
-                proc.stime = stoll(fields[12]); // System CPU time in ticks (field 15)
-                proc.vsize = stoll(fields[20]); // Virtual memory size in bytes (field 23)
-                proc.rss = stoll(fields[21]);   // Resident set size in pages (field 24)
-            }
+            const TaskDelays &now = proc.delays;
+            const TaskDelays &then = prev_it->delays;
+            double interval_ns = time_sec * 1e9;
+
+            proc.cpu_percent = intervalPercent(now.cpu_run_ns, then.cpu_run_ns, interval_ns);
+            if (!proc.has_delays || !prev_it->has_delays)
+                continue;
+            proc.run_delay_percent = intervalPercent(now.cpu_delay_ns, then.cpu_delay_ns, interval_ns);
+            proc.io_delay_percent = intervalPercent(now.blkio_delay_ns + now.swapin_delay_ns,
+                                                    then.blkio_delay_ns + then.swapin_delay_ns, interval_ns);
+            continue;
         }
-    }
 
-    return proc;
+        // Calculate CPU usage from previous measurement
+        long long cpu_diff = (proc.utime + proc.stime) - (prev_it->utime + prev_it->stime);
+
+        // sysconf(_SC_CLK_TCK) gives ticks per second
+        double cpu_percent = (cpu_diff / time_sec) / ticks_per_sec * 100.0;
+        proc.cpu_percent = min(cpu_percent, 100.0);
+    }
 }
 
 /**
- * @brief Retrieves list of all running processes
- * @return Vector of Proc structures containing process information
- * @details Scans /proc directory for numeric subdirectories (PIDs)
- *          and retrieves information for each valid process.
- *          Skips processes that disappear during scanning.
+ * @brief Scans /proc once and publishes a new ProcessSnapshot
+ * @details Called by the sampler thread every 3 seconds. The state counts,
+ *          the process table and the per-process CPU usage are all derived
+ *          from this single walk. The snapshot is immutable once published,
+ *          so the render thread can keep using the previous one while a new
+ *          scan is in progress.
  */
-vector<Proc> getAllProcesses()
+void updateProcessSnapshot()
 {
-    vector<Proc> processes;
-
-    DIR *proc_dir = opendir("/proc");
-    if (proc_dir == nullptr)
-    {
-        return processes;
-    }
-
-    struct dirent *entry;
-    while ((entry = readdir(proc_dir)) != nullptr)
-    {
-        // Check if directory name is numeric (indicates a PID)
-        if (entry->d_type == DT_DIR)
-        {
-            string dir_name = entry->d_name;
-            if (all_of(dir_name.begin(), dir_name.end(), ::isdigit))
-            {
-                int pid = stoi(dir_name);
-                try
-                {
-                    Proc proc = getProcessInfo(pid);
-                    if (!proc.name.empty())
-                    {
-                        processes.push_back(proc);
-                    }
-                }
-                catch (...)
-                {
-                    // Process might have disappeared during scanning, skip it
-                    continue;
-                }
-            }
-        }
-    }
-
-    closedir(proc_dir);
-    return processes;
+    shared_ptr<const ProcessSnapshot> previous = latest_snapshot;
+
+    auto snapshot = make_shared<ProcessSnapshot>();
+    snapshot->processes = getAllProcesses();
+    snapshot->events = takeProcessEventCounts(snapshot->short_lived);
+    snapshot->events_active = processEventsActive();
+    snapshot->taskstats_active = any_of(snapshot->processes.begin(), snapshot->processes.end(),
+                                        [](const Proc &proc)
+                                        { return proc.has_taskstats; });
+    snapshot->delays_active = any_of(snapshot->processes.begin(), snapshot->processes.end(),
+                                     [](const Proc &proc)
+                                     { return proc.has_delays; });
+    snapshot->taken_at = chrono::steady_clock::now();
+    snapshot->generation = previous->generation + 1;
+
+    sort(snapshot->processes.begin(), snapshot->processes.end(),
+         [](const Proc &a, const Proc &b)
+         { return a.pid < b.pid; });
+
+    snapshot->counts = getProcessCounts(snapshot->processes);
+    updateProcessCPUData(*snapshot, *previous);
+    buildProcessSortKeys(*snapshot);
+    buildProcessLowerNames(*snapshot);
+
+    latest_snapshot = snapshot;
+    snapshot_buffer.writeBuffer() = move(snapshot);
+    snapshot_buffer.publish();
 }
 
 /**
- * @brief Updates CPU usage data for all processes
- * @details Calculates CPU usage percentage by comparing current CPU times
- *          with previous readings. Updates are throttled to every 3 seconds
- *          to provide stable measurements.
- * 
- * CPU Usage Calculation:
- * - Reads utime and stime from /proc/[pid]/stat
- * - Calculates difference from previous reading
- * - Converts CPU ticks to percentage using system clock ticks per second
- * - Thread-safe using mutex protection
+ * @brief Returns the most recently published process snapshot
+ * @return Shared pointer to an immutable ProcessSnapshot
+ * @note Render thread only (the single consumer of snapshot_buffer). Older
+ *       snapshots are released by the sampler when it reuses their slot.
  */
-void updateProcessCPUData()
+shared_ptr<const ProcessSnapshot> getProcessSnapshot()
 {
-    auto now = chrono::steady_clock::now();
-
-    // Update only every 3 seconds to get stable CPU measurements
-    if (chrono::duration_cast<chrono::milliseconds>(now - last_process_update).count() < 3000)
-    {
-        return;
-    }
-
-    vector<Proc> current_processes = getAllProcesses();
-    lock_guard<mutex> lock(process_cpu_mutex);
-    
-    for (const auto &proc : current_processes)
-    {
-        long long current_total = proc.utime + proc.stime;
-
-        auto it = process_cpu_data.find(proc.pid);
-        if (it != process_cpu_data.end())
-        {
-            // Calculate CPU usage from previous measurement
-            long long prev_total = it->second.prev_utime + it->second.prev_stime;
-            long long cpu_diff = current_total - prev_total;
-
-            // Calculate percentage based on time difference
-            auto time_diff = chrono::duration_cast<chrono::milliseconds>(now - it->second.last_update);
-            if (time_diff.count() > 0)
-            {
-                // Convert CPU ticks to percentage
-                // sysconf(_SC_CLK_TCK) gives ticks per second
-                double time_sec = time_diff.count() / 1000.0;
-                double cpu_percent = (cpu_diff / time_sec) / sysconf(_SC_CLK_TCK) * 100.0;
-
-                // Update data with bounds checking
-                it->second.prev_utime = proc.utime;
-                it->second.prev_stime = proc.stime;
-                it->second.cpu_percent = min(cpu_percent, 100.0);
-                it->second.last_update = now;
-            }
-        }
-        else
-        {
-            // First time seeing this process - initialize data
-            process_cpu_data[proc.pid] = {proc.utime, proc.stime, 0.0f, now};
-        }
-    }
+    const shared_ptr<const ProcessSnapshot> &snapshot = snapshot_buffer.read();
+    return snapshot ? snapshot : empty_snapshot;
+}
 
-    last_process_update = now;
+/**
+ * @brief Returns the snapshot the sampler published last
+ * @note Sampler thread only; other collectors use it to avoid a second scan
+ */
+shared_ptr<const ProcessSnapshot> latestProcessSnapshot()
+{
+    return latest_snapshot;
 }
 
 /**
@@ -506,247 +374,343 @@ vector<Proc> filterProcesses(const vector<Proc> &processes, const string &filter
 }
 
 /**
- * @brief Handles process selection logic
- * @details Currently provides a placeholder for selection handling.
- *          Selection state is maintained in the selected_pids global set.
- *          Could be extended to provide actions on selected processes.
+ * @brief Process table sort comparator
+ * @param a,b Processes to compare
+ * @param column Table column user ID (0 PID, 1 Name, 2 State, 3 CPU %,
+ *               4 Memory %, 5 Run delay, 6 IO delay)
+ * @param ascending Sort direction
+ * @param total_ram Total RAM in bytes, for the Memory % column
+ * @return true if @p a sorts before @p b
+ */
+bool compareProcesses(const Proc &a, const Proc &b, int column, bool ascending, unsigned long total_ram)
+{
+    switch (column)
+    {
+    case 0: // PID
+        return ascending ? a.pid < b.pid : a.pid > b.pid;
+    case 1: // Name
+        return ascending ? a.name < b.name : a.name > b.name;
+    case 2: // State
+        return ascending ? a.state < b.state : a.state > b.state;
+    case 3: // CPU %
+        return ascending ? a.cpu_percent < b.cpu_percent : a.cpu_percent > b.cpu_percent;
+    case 4: // Memory %
+        return ascending ? calculateProcessMemory(a, total_ram) < calculateProcessMemory(b, total_ram)
+                         : calculateProcessMemory(a, total_ram) > calculateProcessMemory(b, total_ram);
+    case 5: // Run delay
+        return ascending ? a.run_delay_percent < b.run_delay_percent : a.run_delay_percent > b.run_delay_percent;
+    case 6: // IO delay
+        return ascending ? a.io_delay_percent < b.io_delay_percent : a.io_delay_percent > b.io_delay_percent;
+    default:
+        return false;
+    }
+}
+
+// =============================================================================
+// PROCESS TABLE VIEW
+// =============================================================================
+
+/**
+ * @brief Maps a float to an unsigned key with the same order
+ * @details Positive floats order like their bit patterns once the sign bit
+ *          is set; negative ones order in reverse, so all their bits flip.
  */
-void handleProcessSelection()
+static inline uint32_t floatSortKey(float value)
 {
-    // Currently we just show selected processes as highlighted
-    // This function could be extended to provide actions on selected processes
-    // such as killing, changing priority, etc.
+    if (value == 0.0f)
+        value = 0.0f; // -0 and +0 compare equal
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
 }
 
 /**
- * @brief Retrieves cached CPU usage for a specific process
- * @param pid Process ID to query
- * @return CPU usage percentage as float (0.0 to 100.0)
- * @details Thread-safe access to cached CPU usage data.
- *          Returns 0.0 if process data is not available.
+ * @brief Materializes the sort key of every numeric column of the snapshot
+ * @details Called by the sampler before the snapshot is published, so the
+ *          render thread sorts contiguous integer keys instead of calling a
+ *          comparator on Proc structures. Memory % is keyed by RSS pages,
+ *          which orders the same as the percentage.
  */
-float getProcessCPUUsage(int pid)
+void buildProcessSortKeys(ProcessSnapshot &snapshot)
 {
-    lock_guard<mutex> lock(process_cpu_mutex);
-    auto it = process_cpu_data.find(pid);
-    if (it != process_cpu_data.end())
+    const vector<Proc> &processes = snapshot.processes;
+    size_t n = processes.size();
+    for (int column = 0; column < PROCESS_COLUMN_COUNT; column++)
+        snapshot.sort_keys[column].resize(column == PROCESS_COLUMN_NAME ? 0 : n);
+
+    uint32_t *pid = snapshot.sort_keys[PROCESS_COLUMN_PID].data();
+    uint32_t *state = snapshot.sort_keys[PROCESS_COLUMN_STATE].data();
+    uint32_t *cpu = snapshot.sort_keys[PROCESS_COLUMN_CPU].data();
+    uint32_t *memory = snapshot.sort_keys[PROCESS_COLUMN_MEMORY].data();
+    uint32_t *run_delay = snapshot.sort_keys[PROCESS_COLUMN_RUN_DELAY].data();
+    uint32_t *io_delay = snapshot.sort_keys[PROCESS_COLUMN_IO_DELAY].data();
+    for (size_t i = 0; i < n; i++)
     {
-        return it->second.cpu_percent;
+        const Proc &proc = processes[i];
+        pid[i] = (uint32_t)max(proc.pid, 0);
+        state[i] = (unsigned char)proc.state;
+        cpu[i] = floatSortKey(proc.cpu_percent);
+        memory[i] = (uint32_t)min<long long>(max(proc.rss, 0LL), UINT32_MAX);
+        run_delay[i] = floatSortKey(proc.run_delay_percent);
+        io_delay[i] = floatSortKey(proc.io_delay_percent);
     }
-    return 0.0f;
 }
 
-//=============================================================================
-// USER INTERFACE FUNCTIONS
-//=============================================================================
+/**
+ * @brief Stores every process name lowercased, back to back, for the filter
+ * @details Called by the sampler before the snapshot is published, so typing
+ *          in the filter box never lowercases a name on the render thread.
+ */
+void buildProcessLowerNames(ProcessSnapshot &snapshot)
+{
+    const vector<Proc> &processes = snapshot.processes;
+    size_t total = 0;
+    for (const Proc &proc : processes)
+        total += proc.name.size();
+
+    snapshot.lower_names.clear();
+    snapshot.lower_names.reserve(total);
+    snapshot.lower_name_offsets.resize(processes.size() + 1);
+    for (size_t i = 0; i < processes.size(); i++)
+    {
+        snapshot.lower_name_offsets[i] = (uint32_t)snapshot.lower_names.size();
+        for (char c : processes[i].name)
+            snapshot.lower_names += (char)tolower((unsigned char)c);
+    }
+    snapshot.lower_name_offsets[processes.size()] = (uint32_t)snapshot.lower_names.size();
+}
 
 /**
- * @brief Renders the main process table with filtering and sorting
- * @param processes Reference to vector of processes to display
- * @details Creates an ImGui table with the following features:
- *          - Process filtering by name
- *          - Multi-selection with Ctrl+Click
- *          - Sortable columns (PID, Name, State, CPU%, Memory%)
- *          - Color-coded process states and high resource usage
- *          - Real-time CPU and memory usage updates
- * 
- * Table Columns:
- * - PID: Process ID (sortable)
- * - Name: Process name (sortable)
- * - State: Process state with color coding (sortable)
- * - CPU %: CPU usage percentage (sortable)
- * - Memory %: Memory usage percentage (sortable)
- * 
- * Interaction:
- * - Click to select single process
- * - Ctrl+Click to select multiple processes
- * - Click column headers to sort
- * - Type in filter box to filter by name
+ * @brief Brings the rows up to date with @p snapshot, @p filter and @p sort
+ * @details A new snapshot generation rebuilds the row set and sorts it; a new
+ *          sort reorders the existing rows; a new filter narrows or restores
+ *          rows when it can (see changeFilter()); otherwise nothing is done,
+ *          so an unchanged table costs three comparisons.
+ */
+void ProcessTableView::update(const shared_ptr<const ProcessSnapshot> &snapshot, const char *filter,
+                              const vector<ProcessSortSpec> &sort)
+{
+    bool new_snapshot = this->snapshot == nullptr || snapshot->generation != generation;
+    bool new_sort = sort != sort_specs;
+
+    // Kept results index the old snapshot or follow the old order
+    if (new_snapshot || new_sort)
+        wider_results.clear();
+
+    if (new_snapshot)
+    {
+        this->snapshot = snapshot;
+        generation = snapshot->generation;
+        this->filter = filter;
+        lower_filter = this->filter;
+        transform(lower_filter.begin(), lower_filter.end(), lower_filter.begin(), ::tolower);
+        sort_specs = sort;
+        filterRows();
+        sortRows();
+        return;
+    }
+    if (new_sort)
+    {
+        sort_specs = sort;
+        sortRows();
+    }
+    if (this->filter != filter)
+        changeFilter(filter);
+}
+
+/**
+ * @brief Applies a new filter to the same snapshot and sort
+ * @details Typing usually extends the filter, and every name matching the
+ *          longer filter also matches the shorter one, so the current rows
+ *          are narrowed (keeping their order, so no re-sort) and kept in
+ *          wider_results. Deleting characters returns to a kept result, or
+ *          narrows the widest kept result the new filter still extends. Only
+ *          a filter unrelated to all of them scans every process again.
+ */
+void ProcessTableView::changeFilter(const char *new_filter)
+{
+    filter = new_filter;
+    string lower = filter;
+    transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    if (lower == lower_filter)
+        return; // only the case changed
+
+    // Every kept filter is a substring of lower_filter; drop those lower no longer extends
+    while (!wider_results.empty() && lower.find(wider_results.back().lower_filter) == string::npos)
+        wider_results.pop_back();
+
+    if (lower.find(lower_filter) != string::npos)
+    {
+        wider_results.push_back({move(lower_filter), move(rows)});
+        lower_filter = move(lower);
+        narrowRows(wider_results.back().rows);
+    }
+    else if (!wider_results.empty() && wider_results.back().lower_filter == lower)
+    {
+        rows = move(wider_results.back().rows);
+        lower_filter = move(lower);
+        wider_results.pop_back();
+    }
+    else if (!wider_results.empty())
+    {
+        lower_filter = move(lower);
+        narrowRows(wider_results.back().rows);
+    }
+    else
+    {
+        lower_filter = move(lower);
+        filterRows();
+        sortRows();
+    }
+}
+
+/**
+ * @brief Whether process @p index's name contains lower_filter
+ */
+bool ProcessTableView::nameMatches(uint32_t index)
+{
+    const ProcessSnapshot &current = *snapshot;
+    if (current.lower_name_offsets.size() == current.processes.size() + 1)
+    {
+        uint32_t begin = current.lower_name_offsets[index];
+        uint32_t end = current.lower_name_offsets[index + 1];
+        return memmem(current.lower_names.data() + begin, end - begin,
+                      lower_filter.data(), lower_filter.size()) != nullptr;
+    }
+
+    // Snapshot built without buildProcessLowerNames()
+    lower_scratch = current.processes[index].name;
+    transform(lower_scratch.begin(), lower_scratch.end(), lower_scratch.begin(), ::tolower);
+    return lower_scratch.find(lower_filter) != string::npos;
+}
+
+/**
+ * @brief Collects the indices of the processes whose name contains the filter
+ *        (case-insensitive), in snapshot (PID) order
+ */
+void ProcessTableView::filterRows()
+{
+    const vector<Proc> &processes = snapshot->processes;
+    rows.clear();
+    rows_in_pid_order = true;
+    rebuild_count++;
+
+    if (lower_filter.empty())
+    {
+        rows.resize(processes.size());
+        iota(rows.begin(), rows.end(), 0);
+        return;
+    }
+    for (uint32_t i = 0; i < (uint32_t)processes.size(); i++)
+    {
+        if (nameMatches(i))
+            rows.push_back(i);
+    }
+}
+
+/**
+ * @brief Keeps the rows of @p from whose name contains the filter, in order
+ */
+void ProcessTableView::narrowRows(const vector<uint32_t> &from)
+{
+    rows.clear();
+    rebuild_count++;
+    for (uint32_t index : from)
+    {
+        if (nameMatches(index))
+            rows.push_back(index);
+    }
+}
+
+/**
+ * @brief Stable LSD radix sort of the rows on one key column
+ * @details Sorts (key << 32 | row) items eight bits at a time, counting all
+ *          four digits in one pass and skipping digits that every key
+ *          shares (PIDs never use the top byte, states only use the low
+ *          one). Descending order inverts the keys, so ties keep their
+ *          current order either way.
  */
-void renderProcessTable(vector<Proc> &processes)
+void ProcessTableView::radixSortRows(const vector<uint32_t> &keys, bool ascending)
 {
-    MemoryInfo mem_info = getMemoryInfo();
-    updateProcessCPUData();  // Update process CPU data periodically
-
-    // Process Filter Input
-    ImGui::Text("Filter processes:");
-    ImGui::SameLine();
-    ImGui::InputText("##ProcessFilter", process_filter, sizeof(process_filter));
-
-    // Apply filter to process list
-    vector<Proc> filtered_processes = filterProcesses(processes, string(process_filter));
-
-    // Display process count and selection info
-    ImGui::Text("Processes: %zu (Selected: %zu)", filtered_processes.size(), selected_pids.size());
-    
-    // Clear selection button
-    ImGui::SameLine();
-    if (ImGui::Button("Clear Selection"))
+    size_t n = rows.size();
+    if (keys.size() != snapshot->processes.size())
+        return; // snapshot built without buildProcessSortKeys()
+
+    vector<uint64_t> &items = sort_items[0];
+    vector<uint64_t> &scratch = sort_items[1];
+    items.resize(n);
+    scratch.resize(n);
+
+    uint32_t flip = ascending ? 0 : 0xFFFFFFFFu;
+    size_t counts[4][256] = {};
+    for (size_t i = 0; i < n; i++)
     {
-        selected_pids.clear();
+        uint32_t key = keys[rows[i]] ^ flip;
+        items[i] = ((uint64_t)key << 32) | rows[i];
+        for (int digit = 0; digit < 4; digit++)
+            counts[digit][(key >> (8 * digit)) & 0xFF]++;
     }
 
-    // User instructions
-    ImGui::TextColored(ImVec4(0.5f, 0.5f, 0.5f, 1.0f), "Tip: Ctrl+Click to select multiple processes, Click column headers to sort");
-
-    // Create sortable, resizable table
-    if (ImGui::BeginTable("ProcessTable", 5,
-                          ImGuiTableFlags_Sortable |
-                              ImGuiTableFlags_Resizable |
-                              ImGuiTableFlags_ScrollY |
-                              ImGuiTableFlags_RowBg |
-                              ImGuiTableFlags_BordersOuter |
-                              ImGuiTableFlags_BordersV))
+    for (int digit = 0; digit < 4; digit++)
     {
-        // Setup table columns with sizing and sorting options
-        ImGui::TableSetupColumn("PID", ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_WidthFixed, 80.0f, 0);
-        ImGui::TableSetupColumn("Name", ImGuiTableColumnFlags_None, 150.0f, 1);
-        ImGui::TableSetupColumn("State", ImGuiTableColumnFlags_None | ImGuiTableColumnFlags_WidthFixed, 100.0f, 2);
-        ImGui::TableSetupColumn("CPU %", ImGuiTableColumnFlags_None | ImGuiTableColumnFlags_WidthFixed, 80.0f, 3);
-        ImGui::TableSetupColumn("Memory %", ImGuiTableColumnFlags_None | ImGuiTableColumnFlags_WidthFixed, 100.0f, 4);
-        ImGui::TableSetupScrollFreeze(0, 1); // Freeze header row when scrolling
-        ImGui::TableHeadersRow();
-
-        // Handle table sorting
-        ImGuiTableSortSpecs *sort_specs = ImGui::TableGetSortSpecs();
-        if (sort_specs && sort_specs->SpecsDirty)
+        int shift = 32 + 8 * digit;
+        if (counts[digit][(items[0] >> shift) & 0xFF] == n)
+            continue;
+
+        size_t offsets[256];
+        size_t total = 0;
+        for (int bucket = 0; bucket < 256; bucket++)
         {
-            if (sort_specs->SpecsCount > 0)
-            {
-                const ImGuiTableColumnSortSpecs *spec = &sort_specs->Specs[0];
-
-                // Sort processes based on selected column and direction
-                sort(filtered_processes.begin(), filtered_processes.end(),
-                     [spec, &mem_info](const Proc &a, const Proc &b)
-                     {
-                         bool ascending = spec->SortDirection == ImGuiSortDirection_Ascending;
-
-                         switch (spec->ColumnUserID)
-                         {
-                         case 0: // PID
-                             return ascending ? a.pid < b.pid : a.pid > b.pid;
-                         case 1: // Name
-                             return ascending ? a.name < b.name : a.name > b.name;
-                         case 2: // State
-                             return ascending ? a.state < b.state : a.state > b.state;
-                         case 3: // CPU %
-                             return ascending ? getProcessCPUUsage(a.pid) < getProcessCPUUsage(b.pid)
-                                              : getProcessCPUUsage(a.pid) > getProcessCPUUsage(b.pid);
-                         case 4: // Memory %
-                             return ascending ? calculateProcessMemory(a, mem_info.total_ram) < calculateProcessMemory(b, mem_info.total_ram)
-                                              : calculateProcessMemory(a, mem_info.total_ram) > calculateProcessMemory(b, mem_info.total_ram);
-                         default:
-                             return false;
-                         }
-                     });
-            }
-            sort_specs->SpecsDirty = false;
+            offsets[bucket] = total;
+            total += counts[digit][bucket];
         }
+        for (uint64_t item : items)
+            scratch[offsets[(item >> shift) & 0xFF]++] = item;
+        items.swap(scratch);
+    }
+
+    for (size_t i = 0; i < n; i++)
+        rows[i] = (uint32_t)items[i];
+}
 
-        // Render table rows
-        for (const auto &proc : filtered_processes)
+/**
+ * @brief Orders the rows by the sort columns, most significant first
+ * @details Each column is a stable sort, applied from the least significant
+ *          column to the most significant one, starting from PID order, so
+ *          rows equal on every column keep PID order and the order does not
+ *          change between frames or snapshots for equal keys. Numeric
+ *          columns are radix sorted; Name is a stable comparison sort.
+ */
+void ProcessTableView::sortRows()
+{
+    if (rows.empty())
+        return;
+
+    // Filtering produces PID order (snapshot order); a re-sort starts over from it
+    if (!rows_in_pid_order)
+    {
+        radixSortRows(snapshot->sort_keys[PROCESS_COLUMN_PID], true);
+        rows_in_pid_order = true;
+    }
+
+    const vector<Proc> &processes = snapshot->processes;
+    for (auto spec = sort_specs.rbegin(); spec != sort_specs.rend(); ++spec)
+    {
+        if (spec->column == PROCESS_COLUMN_NAME)
         {
-            ImGui::TableNextRow();
-            bool is_selected = selected_pids.find(proc.pid) != selected_pids.end();
-            
-            // PID column with selection handling
-            ImGui::TableSetColumnIndex(0);
-            if (ImGui::Selectable(("##" + to_string(proc.pid)).c_str(), is_selected,
-                                  ImGuiSelectableFlags_SpanAllColumns))
-            {
-                // Handle multi-selection with Ctrl+Click
-                ImGuiIO &io = ImGui::GetIO();
-                if (io.KeyCtrl)
-                {
-                    // Toggle selection
-                    if (is_selected)
-                    {
-                        selected_pids.erase(proc.pid);
-                    }
-                    else
-                    {
-                        selected_pids.insert(proc.pid);
-                    }
-                }
-                else
-                {
-                    // Single selection
-                    selected_pids.clear();
-                    selected_pids.insert(proc.pid);
-                }
-            }
-
-            // Display PID in the same cell as selection
-            ImGui::SameLine();
-            ImGui::Text("%d", proc.pid);
-
-            // Name column
-            ImGui::TableSetColumnIndex(1);
-            ImGui::Text("%s", proc.name.c_str());
-
-            // State column with color coding
-            ImGui::TableSetColumnIndex(2);
-            string state_str;
-            ImVec4 state_color = ImVec4(1.0f, 1.0f, 1.0f, 1.0f); // Default white
-            
-            // Map process state to human-readable string and color
-            switch (proc.state)
-            {
-            case 'R':
-                state_str = "Running";
-                state_color = ImVec4(0.0f, 1.0f, 0.0f, 1.0f); // Green
-                break;
-            case 'S':
-                state_str = "Sleeping";
-                state_color = ImVec4(0.0f, 0.7f, 1.0f, 1.0f); // Blue
-                break;
-            case 'D':
-                state_str = "Disk Sleep";
-                state_color = ImVec4(1.0f, 0.7f, 0.0f, 1.0f); // Orange
-                break;
-            case 'I':
-                state_str = "Idle";
-                state_color = ImVec4(1.0f, 0.0f, 1.0f, 1.0f); // Magenta
-                break;
-            case 'Z':
-                state_str = "Zombie";
-                state_color = ImVec4(1.0f, 0.0f, 0.0f, 1.0f); // Red
-                break;
-            case 'T':
-                state_str = "Stopped";
-                state_color = ImVec4(0.7f, 0.7f, 0.7f, 1.0f); // Gray
-                break;
-            default:
-                state_str = string(1, proc.state);
-                break;
-            }
-            ImGui::TextColored(state_color, "%s", state_str.c_str());
-
-            // CPU % column with highlighting for high usage
-            ImGui::TableSetColumnIndex(3);
-            float cpu_usage = getProcessCPUUsage(proc.pid);
-            if (cpu_usage > 0.1f)
-            {
-                ImGui::TextColored(ImVec4(1.0f, 0.8f, 0.0f, 1.0f), "%.1f%%", cpu_usage);
-            }
-            else
-            {
-                ImGui::Text("%.1f%%", cpu_usage);
-            }
-
-            // Memory % column with highlighting for high usage
-            ImGui::TableSetColumnIndex(4);
-            float memory_usage = calculateProcessMemory(proc, mem_info.total_ram);
-            if (memory_usage > 1.0f)
-            {
-                ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.0f, 1.0f), "%.1f%%", memory_usage);
-            }
-            else
-            {
-                ImGui::Text("%.1f%%", memory_usage);
-            }
+            bool ascending = spec->ascending;
+            stable_sort(rows.begin(), rows.end(), [&](uint32_t a, uint32_t b)
+                        {
+                int order = processes[a].name.compare(processes[b].name);
+                return ascending ? order < 0 : order > 0; });
+        }
+        else if (spec->column >= 0 && spec->column < PROCESS_COLUMN_COUNT)
+        {
+            radixSortRows(snapshot->sort_keys[spec->column], spec->ascending);
         }
-
-        ImGui::EndTable();
     }
+
+    // PIDs are unique, so a primary ascending PID sort is exactly PID order
+    if (!sort_specs.empty())
+        rows_in_pid_order = sort_specs[0].column == PROCESS_COLUMN_PID && sort_specs[0].ascending;
 }
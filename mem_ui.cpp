@@ -0,0 +1,381 @@
+/**
+ * @file mem_ui.cpp
+ * @brief ImGui views of the memory and process collectors
+ * @details Draws the RAM/SWAP/disk bars and the filterable, sortable process
+ *          table from the data published by mem.cpp. Selection and filter
+ *          state belong to the render thread and live here.
+ * @author Stephen Kisengese
+ * @date 2025
+ */
+
+#include "header.h"
+
+//=============================================================================
+// GLOBAL VARIABLES
+//=============================================================================
+
+// Process selection and filtering
+static set<int> selected_pids;                     ///< Set of currently selected process IDs
+static char process_filter[256] = "";              ///< Process name filter string
+static vector<ProcessSortSpec> process_sort;       ///< Table sort, refreshed when ImGui reports it dirty
+static ProcessTableView process_view;              ///< Filtered, sorted rows of the current snapshot
+
+//=============================================================================
+// MEMORY USAGE BARS
+//=============================================================================
+
+/**
+ * @brief Determines color based on usage percentage
+ * @param percentage Usage percentage (0.0 to 100.0)
+ * @return ImVec4 color value for ImGui rendering
+ * @details Color coding:
+ *          - Green: < 70% usage (safe)
+ *          - Yellow: 70-90% usage (warning)
+ *          - Red: > 90% usage (critical)
+ */
+ImVec4 getUsageColor(float percentage)
+{
+    if (percentage < 70.0f)
+    {
+        return ImVec4(0.0f, 0.8f, 0.0f, 1.0f); // Green
+    }
+    else if (percentage < 90.0f)
+    {
+        return ImVec4(1.0f, 1.0f, 0.0f, 1.0f); // Yellow
+    }
+    else
+    {
+        return ImVec4(1.0f, 0.0f, 0.0f, 1.0f); // Red
+    }
+}
+
+/**
+ * @brief Renders memory usage bars in the ImGui interface
+ * @details Creates visual progress bars for RAM, SWAP, and disk usage
+ *          with color-coded indicators and formatted text labels.
+ *          Each bar shows percentage, used/total amounts, and visual indicator.
+ * 
+ * Layout:
+ * - RAM Usage: Always displayed
+ * - SWAP Usage: Only displayed if swap is available
+ * - Disk Usage: Shows root filesystem usage
+ */
+void renderMemoryBars()
+{
+    const MemoryInfo &mem_info = getCachedMemoryInfo();
+
+    // RAM Usage Bar
+    float ram_percentage = calculateMemoryUsage(mem_info.used_ram, mem_info.total_ram);
+    ImGui::Text("RAM Usage:");
+    ImGui::SameLine();
+    ImGui::Text("%.1f%% (%s / %s)",
+                ram_percentage,
+                formatBytes(mem_info.used_ram).c_str(),
+                formatBytes(mem_info.total_ram).c_str());
+
+    ImGui::PushStyleColor(ImGuiCol_PlotHistogram, getUsageColor(ram_percentage));
+    ImGui::ProgressBar(ram_percentage / 100.0f, ImVec2(-1, 0));
+    ImGui::PopStyleColor();
+
+    ImGui::Separator();
+
+    // SWAP Usage Bar (only if swap is available)
+    if (mem_info.total_swap > 0)
+    {
+        float swap_percentage = calculateMemoryUsage(mem_info.used_swap, mem_info.total_swap);
+        ImGui::Text("SWAP Usage:");
+        ImGui::SameLine();
+        ImGui::Text("%.1f%% (%s / %s)",
+                    swap_percentage,
+                    formatBytes(mem_info.used_swap).c_str(),
+                    formatBytes(mem_info.total_swap).c_str());
+
+        ImGui::PushStyleColor(ImGuiCol_PlotHistogram, getUsageColor(swap_percentage));
+        ImGui::ProgressBar(swap_percentage / 100.0f, ImVec2(-1, 0));
+        ImGui::PopStyleColor();
+    }
+    else
+    {
+        ImGui::Text("SWAP Usage: Not available");
+        ImGui::ProgressBar(0.0f, ImVec2(-1, 0));
+    }
+
+    ImGui::Separator();
+
+    // Disk Usage Bar
+    float disk_percentage = calculateMemoryUsage(mem_info.used_disk, mem_info.total_disk);
+    ImGui::Text("Disk Usage (/):");
+    ImGui::SameLine();
+    ImGui::Text("%.1f%% (%s / %s)",
+                disk_percentage,
+                formatBytes(mem_info.used_disk).c_str(),
+                formatBytes(mem_info.total_disk).c_str());
+
+    ImGui::PushStyleColor(ImGuiCol_PlotHistogram, getUsageColor(disk_percentage));
+    ImGui::ProgressBar(disk_percentage / 100.0f, ImVec2(-1, 0));
+    ImGui::PopStyleColor();
+}
+
+
+/**
+ * @brief Handles process selection logic
+ * @details Currently provides a placeholder for selection handling.
+ *          Selection state is maintained in the selected_pids global set.
+ *          Could be extended to provide actions on selected processes.
+ */
+void handleProcessSelection()
+{
+    // Currently we just show selected processes as highlighted
+    // This function could be extended to provide actions on selected processes
+    // such as killing, changing priority, etc.
+}
+
+//=============================================================================
+// USER INTERFACE FUNCTIONS
+//=============================================================================
+
+/**
+ * @brief Renders one delay percentage cell of the process table
+ * @details Shows a dimmed dash when taskstats did not report on the process
+ *          (no --taskstats, taskstats unavailable, or kernel.task_delayacct is off).
+ */
+static void renderDelayCell(const Proc &proc, float delay_percent)
+{
+    if (!proc.has_delays)
+    {
+        ImGui::TextDisabled("-");
+    }
+    else if (delay_percent > 1.0f)
+    {
+        ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "%.1f%%", delay_percent);
+    }
+    else
+    {
+        ImGui::Text("%.1f%%", delay_percent);
+    }
+}
+
+/**
+ * @brief Human-readable label and color of a process state
+ * @param label_buffer Receives the raw state letter for unknown states
+ */
+static const char *processStateLabel(char state, ImVec4 &color, char (&label_buffer)[2])
+{
+    color = ImVec4(1.0f, 1.0f, 1.0f, 1.0f); // Default white
+    switch (state)
+    {
+    case 'R':
+        color = ImVec4(0.0f, 1.0f, 0.0f, 1.0f); // Green
+        return "Running";
+    case 'S':
+        color = ImVec4(0.0f, 0.7f, 1.0f, 1.0f); // Blue
+        return "Sleeping";
+    case 'D':
+        color = ImVec4(1.0f, 0.7f, 0.0f, 1.0f); // Orange
+        return "Disk Sleep";
+    case 'I':
+        color = ImVec4(1.0f, 0.0f, 1.0f, 1.0f); // Magenta
+        return "Idle";
+    case 'Z':
+        color = ImVec4(1.0f, 0.0f, 0.0f, 1.0f); // Red
+        return "Zombie";
+    case 'T':
+        color = ImVec4(0.7f, 0.7f, 0.7f, 1.0f); // Gray
+        return "Stopped";
+    default:
+        label_buffer[0] = state;
+        label_buffer[1] = '\0';
+        return label_buffer;
+    }
+}
+
+/**
+ * @brief Renders one row of the process table
+ * @details Allocation-free: the row ID is the PID pushed on the ID stack,
+ *          and every cell is formatted by ImGui into its own buffer.
+ */
+static void renderProcessRow(const Proc &proc, unsigned long total_ram)
+{
+    ImGui::TableNextRow();
+    bool is_selected = selected_pids.find(proc.pid) != selected_pids.end();
+
+    // PID column with selection handling
+    ImGui::TableSetColumnIndex(0);
+    ImGui::PushID(proc.pid);
+    if (ImGui::Selectable("##row", is_selected, ImGuiSelectableFlags_SpanAllColumns))
+    {
+        // Handle multi-selection with Ctrl+Click
+        ImGuiIO &io = ImGui::GetIO();
+        if (io.KeyCtrl)
+        {
+            // Toggle selection
+            if (is_selected)
+            {
+                selected_pids.erase(proc.pid);
+            }
+            else
+            {
+                selected_pids.insert(proc.pid);
+            }
+        }
+        else
+        {
+            // Single selection
+            selected_pids.clear();
+            selected_pids.insert(proc.pid);
+        }
+    }
+    ImGui::PopID();
+
+    // Display PID in the same cell as selection
+    ImGui::SameLine();
+    ImGui::Text("%d", proc.pid);
+
+    // Name column
+    ImGui::TableSetColumnIndex(1);
+    ImGui::TextUnformatted(proc.name.c_str(), proc.name.c_str() + proc.name.size());
+
+    // State column with color coding
+    ImGui::TableSetColumnIndex(2);
+    ImVec4 state_color;
+    char state_buffer[2];
+    const char *state_label = processStateLabel(proc.state, state_color, state_buffer);
+    ImGui::TextColored(state_color, "%s", state_label);
+
+    // CPU % column with highlighting for high usage
+    ImGui::TableSetColumnIndex(3);
+    float cpu_usage = proc.cpu_percent;
+    if (cpu_usage > 0.1f)
+    {
+        ImGui::TextColored(ImVec4(1.0f, 0.8f, 0.0f, 1.0f), "%.1f%%", cpu_usage);
+    }
+    else
+    {
+        ImGui::Text("%.1f%%", cpu_usage);
+    }
+
+    // Memory % column with highlighting for high usage
+    ImGui::TableSetColumnIndex(4);
+    float memory_usage = calculateProcessMemory(proc, total_ram);
+    if (memory_usage > 1.0f)
+    {
+        ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.0f, 1.0f), "%.1f%%", memory_usage);
+    }
+    else
+    {
+        ImGui::Text("%.1f%%", memory_usage);
+    }
+
+    // Delay columns, only available with taskstats
+    ImGui::TableSetColumnIndex(5);
+    renderDelayCell(proc, proc.run_delay_percent);
+    ImGui::TableSetColumnIndex(6);
+    renderDelayCell(proc, proc.io_delay_percent);
+}
+
+/**
+ * @brief Renders the main process table with filtering and sorting
+ * @param snapshot Process snapshot published by the sampler thread
+ * @details Creates an ImGui table with the following features:
+ *          - Process filtering by name
+ *          - Multi-selection with Ctrl+Click
+ *          - Sortable columns (PID, Name, State, CPU%, Memory%, delays)
+ *          - Color-coded process states and high resource usage
+ *          - Real-time CPU and memory usage updates
+ *          - Rows submitted through ImGuiListClipper, so only the visible
+ *            rows cost anything regardless of the process count
+ *          - Filtered and sorted rows kept in process_view as indices into
+ *            the snapshot, recomputed only when the snapshot, the filter or
+ *            the sort changes
+ * 
+ * Table Columns:
+ * - PID: Process ID (sortable)
+ * - Name: Process name (sortable)
+ * - State: Process state with color coding (sortable)
+ * - CPU %: CPU usage percentage (sortable)
+ * - Memory %: Memory usage percentage (sortable)
+ * - Run delay: Share of time spent runnable but waiting for a CPU (sortable)
+ * - IO delay: Share of time spent waiting for block I/O or swap-in (sortable)
+ * 
+ * Interaction:
+ * - Click to select single process
+ * - Ctrl+Click to select multiple processes
+ * - Click column headers to sort, Shift+Click to add a secondary sort column
+ * - Type in filter box to filter by name
+ */
+void renderProcessTable(const shared_ptr<const ProcessSnapshot> &snapshot)
+{
+    TRACE_ZONE("renderProcessTable");
+    const MemoryInfo &mem_info = getCachedMemoryInfo();
+
+    // Process Filter Input
+    ImGui::Text("Filter processes:");
+    ImGui::SameLine();
+    ImGui::InputText("##ProcessFilter", process_filter, sizeof(process_filter));
+
+    // Apply filter to process list (no work unless the snapshot or filter changed)
+    process_view.update(snapshot, process_filter, process_sort);
+
+    // Display process count and selection info
+    ImGui::Text("Processes: %zu (Selected: %zu)", process_view.size(), selected_pids.size());
+    
+    // Clear selection button
+    ImGui::SameLine();
+    if (ImGui::Button("Clear Selection"))
+    {
+        selected_pids.clear();
+    }
+
+    // User instructions
+    ImGui::TextColored(ImVec4(0.5f, 0.5f, 0.5f, 1.0f), "Tip: Ctrl+Click to select multiple processes, Click column headers to sort (Shift+Click adds a column)");
+
+    // Create sortable, resizable table
+    if (ImGui::BeginTable("ProcessTable", 7,
+                          ImGuiTableFlags_Sortable |
+                              ImGuiTableFlags_SortMulti |
+                              ImGuiTableFlags_Resizable |
+                              ImGuiTableFlags_ScrollY |
+                              ImGuiTableFlags_RowBg |
+                              ImGuiTableFlags_BordersOuter |
+                              ImGuiTableFlags_BordersV))
+    {
+        // Setup table columns with sizing and sorting options
+        ImGui::TableSetupColumn("PID", ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_WidthFixed, 80.0f, 0);
+        ImGui::TableSetupColumn("Name", ImGuiTableColumnFlags_None, 150.0f, 1);
+        ImGui::TableSetupColumn("State", ImGuiTableColumnFlags_None | ImGuiTableColumnFlags_WidthFixed, 100.0f, 2);
+        ImGui::TableSetupColumn("CPU %", ImGuiTableColumnFlags_None | ImGuiTableColumnFlags_WidthFixed, 80.0f, 3);
+        ImGui::TableSetupColumn("Memory %", ImGuiTableColumnFlags_None | ImGuiTableColumnFlags_WidthFixed, 100.0f, 4);
+        ImGui::TableSetupColumn("Run delay", ImGuiTableColumnFlags_None | ImGuiTableColumnFlags_WidthFixed, 80.0f, 5);
+        ImGui::TableSetupColumn("IO delay", ImGuiTableColumnFlags_None | ImGuiTableColumnFlags_WidthFixed, 80.0f, 6);
+        ImGui::TableSetupScrollFreeze(0, 1); // Freeze header row when scrolling
+        ImGui::TableHeadersRow();
+
+        // Handle table sorting: the view keeps the order until the sort changes
+        ImGuiTableSortSpecs *sort_specs = ImGui::TableGetSortSpecs();
+        if (sort_specs && sort_specs->SpecsDirty)
+        {
+            process_sort.clear();
+            for (int i = 0; i < sort_specs->SpecsCount; i++)
+            {
+                const ImGuiTableColumnSortSpecs &spec = sort_specs->Specs[i];
+                process_sort.push_back({(int)spec.ColumnUserID, spec.SortDirection == ImGuiSortDirection_Ascending});
+            }
+            sort_specs->SpecsDirty = false;
+            process_view.update(snapshot, process_filter, process_sort);
+        }
+
+        // Only the rows inside the scroll window are submitted
+        unsigned long total_ram = mem_info.total_ram;
+        ImGuiListClipper clipper;
+        clipper.Begin((int)process_view.size());
+        while (clipper.Step())
+        {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+            {
+                renderProcessRow(process_view.row(row), total_ram);
+            }
+        }
+
+        ImGui::EndTable();
+    }
+}
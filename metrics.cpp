@@ -0,0 +1,414 @@
+/**
+ * @file metrics.cpp
+ * @brief Prometheus text-format endpoint on localhost (--metrics-port)
+ * @details The sampler renders the complete HTTP response (headers and the
+ *          Prometheus text body) once per sampler cycle in which a collector
+ *          ran, and hands it to the server thread through a TripleBuffer. A
+ *          scrape is then one read() of the request and one send() of a
+ *          buffer that already exists: no /proc access, no formatting and
+ *          no locks, however often the endpoint is scraped.
+ *
+ *          The server binds 127.0.0.1 only and handles one connection at a
+ *          time with short socket timeouts, so a stalled client delays other
+ *          scrapes by at most a second and never touches the sampler.
+ *
+ * Exported metrics:
+ *   monitor_cpu_usage_percent, monitor_cpu_seconds_total{mode},
+ *   monitor_memory_*_bytes, monitor_swap_*_bytes, monitor_disk_*_bytes,
+ *   monitor_network_{receive,transmit}_{bytes,packets,errors,drops}_total{interface},
+ *   monitor_temperature_celsius, monitor_fan_speed_rpm, monitor_fan_level,
+ *   monitor_fan_active, monitor_processes{state}, monitor_processes_total
+ * @author Stephen Kisengese
+ * @date 2025
+ */
+
+#include "collector.h"
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+
+// =============================================================================
+// SERVER STATE
+// =============================================================================
+
+int metrics_port = 0; ///< --metrics-port PORT; 0 keeps the endpoint disabled
+
+static TripleBuffer<string> metrics_page; ///< Rendered HTTP response, sampler -> server thread
+static string metrics_body;               ///< Scratch for the text body, sampler thread only
+static thread metrics_thread;             ///< Thread running serveMetrics()
+static int metrics_listen_fd = -1;        ///< Listening socket, -1 while stopped
+static int metrics_wakeup[2] = {-1, -1};  ///< Pipe written by stopMetricsServer()
+static atomic<uint64_t> metrics_scrapes(0); ///< Scrapes answered, for the status line
+
+// =============================================================================
+// PAGE RENDERING (sampler thread)
+// =============================================================================
+
+static void addFamily(string &out, const char *name, const char *type, const char *help)
+{
+    out += "# HELP ";
+    out += name;
+    out += ' ';
+    out += help;
+    out += "\n# TYPE ";
+    out += name;
+    out += ' ';
+    out += type;
+    out += '\n';
+}
+
+/**
+ * @brief Appends one sample line; @p labels is either "" or `key="value"` pairs
+ */
+static void addSampleText(string &out, const char *name, const string &labels, const char *number)
+{
+    out += name;
+    if (!labels.empty())
+    {
+        out += '{';
+        out += labels;
+        out += '}';
+    }
+    out += ' ';
+    out += number;
+    out += '\n';
+}
+
+static void addSample(string &out, const char *name, const string &labels, double value)
+{
+    char number[32];
+    snprintf(number, sizeof(number), "%.15g", value);
+    addSampleText(out, name, labels, number);
+}
+
+/**
+ * @brief Appends a 64-bit counter exactly (a double would round past 2^53)
+ */
+static void addCounterSample(string &out, const char *name, const string &labels, uint64_t value)
+{
+    char number[32];
+    snprintf(number, sizeof(number), "%llu", (unsigned long long)value);
+    addSampleText(out, name, labels, number);
+}
+
+/**
+ * @brief Quotes a label value, escaping backslashes, quotes and newlines
+ */
+static string labelValue(const char *key, const string &value)
+{
+    string label = key;
+    label += "=\"";
+    for (char c : value)
+    {
+        if (c == '\\' || c == '"')
+            label += '\\';
+        label += c == '\n' ? 'n' : c;
+    }
+    label += '"';
+    return label;
+}
+
+static void addCPU(string &out)
+{
+    addFamily(out, "monitor_cpu_usage_percent", "gauge", "CPU usage over the last sample interval.");
+    addSample(out, "monitor_cpu_usage_percent", "", current_cpu_usage.load());
+
+    static const double ticks_per_second = (double)sysconf(_SC_CLK_TCK);
+    const CPUStats &stats = latestCPUStats();
+    const struct
+    {
+        const char *mode;
+        long long int ticks;
+    } modes[] = {
+        {"user", stats.user}, {"nice", stats.nice}, {"system", stats.system}, {"idle", stats.idle},
+        {"iowait", stats.iowait}, {"irq", stats.irq}, {"softirq", stats.softirq}, {"steal", stats.steal},
+    };
+    addFamily(out, "monitor_cpu_seconds_total", "counter", "CPU time summed over all CPUs, by mode (/proc/stat).");
+    for (const auto &mode : modes)
+        addSample(out, "monitor_cpu_seconds_total", labelValue("mode", mode.mode), mode.ticks / ticks_per_second);
+}
+
+static void addMemory(string &out)
+{
+    const MemoryInfo &memory = latestMemoryInfo();
+    const struct
+    {
+        const char *name;
+        const char *help;
+        unsigned long value;
+    } gauges[] = {
+        {"monitor_memory_total_bytes", "Total RAM.", memory.total_ram},
+        {"monitor_memory_used_bytes", "RAM in use (total minus available).", memory.used_ram},
+        {"monitor_memory_available_bytes", "RAM available without swapping.", memory.available_ram},
+        {"monitor_swap_total_bytes", "Total swap.", memory.total_swap},
+        {"monitor_swap_used_bytes", "Swap in use.", memory.used_swap},
+        {"monitor_disk_total_bytes", "Size of the root filesystem.", memory.total_disk},
+        {"monitor_disk_used_bytes", "Used space on the root filesystem.", memory.used_disk},
+    };
+    for (const auto &gauge : gauges)
+    {
+        addFamily(out, gauge.name, "gauge", gauge.help);
+        addSample(out, gauge.name, "", (double)gauge.value);
+    }
+}
+
+static void addNetwork(string &out)
+{
+    const NetworkSnapshot &network = latestNetworkSnapshot();
+
+    const struct
+    {
+        const char *name;
+        const char *help;
+        bool transmit;
+        uint64_t RX::*rx_field;
+        uint64_t TX::*tx_field;
+    } counters[] = {
+        {"monitor_network_receive_bytes_total", "Bytes received.", false, &RX::bytes, nullptr},
+        {"monitor_network_receive_packets_total", "Packets received.", false, &RX::packets, nullptr},
+        {"monitor_network_receive_errors_total", "Receive errors.", false, &RX::errs, nullptr},
+        {"monitor_network_receive_drops_total", "Received packets dropped.", false, &RX::drop, nullptr},
+        {"monitor_network_transmit_bytes_total", "Bytes transmitted.", true, nullptr, &TX::bytes},
+        {"monitor_network_transmit_packets_total", "Packets transmitted.", true, nullptr, &TX::packets},
+        {"monitor_network_transmit_errors_total", "Transmit errors.", true, nullptr, &TX::errs},
+        {"monitor_network_transmit_drops_total", "Transmitted packets dropped.", true, nullptr, &TX::drop},
+    };
+    for (const auto &counter : counters)
+    {
+        addFamily(out, counter.name, "counter", counter.help);
+        if (counter.transmit)
+        {
+            for (const auto &pair : network.tx)
+                addCounterSample(out, counter.name, labelValue("interface", pair.first), pair.second.*counter.tx_field);
+        }
+        else
+        {
+            for (const auto &pair : network.rx)
+                addCounterSample(out, counter.name, labelValue("interface", pair.first), pair.second.*counter.rx_field);
+        }
+    }
+}
+
+static void addSensors(string &out)
+{
+    // Families without a sensor are left out rather than reported as 0
+    if (thermal_available.load())
+    {
+        addFamily(out, "monitor_temperature_celsius", "gauge", "CPU temperature.");
+        addSample(out, "monitor_temperature_celsius", "", current_temperature.load());
+    }
+    if (fan_available.load())
+    {
+        addFamily(out, "monitor_fan_speed_rpm", "gauge", "Fan speed.");
+        addSample(out, "monitor_fan_speed_rpm", "", current_fan_speed.load());
+        addFamily(out, "monitor_fan_level", "gauge", "Fan PWM level (0-255).");
+        addSample(out, "monitor_fan_level", "", current_fan_level.load());
+        addFamily(out, "monitor_fan_active", "gauge", "1 if the fan is spinning.");
+        addSample(out, "monitor_fan_active", "", fan_active.load() ? 1 : 0);
+    }
+}
+
+static void addProcesses(string &out)
+{
+    shared_ptr<const ProcessSnapshot> snapshot = latestProcessSnapshot();
+    const ProcessCounts &counts = snapshot->counts;
+    addFamily(out, "monitor_processes", "gauge", "Processes by state at the last scan.");
+    addSample(out, "monitor_processes", labelValue("state", "running"), counts.running);
+    addSample(out, "monitor_processes", labelValue("state", "sleeping"), counts.sleeping);
+    addSample(out, "monitor_processes", labelValue("state", "zombie"), counts.zombie);
+    addSample(out, "monitor_processes", labelValue("state", "stopped"), counts.stopped);
+    addFamily(out, "monitor_processes_total", "gauge", "Processes at the last scan.");
+    addSample(out, "monitor_processes_total", "", counts.total);
+}
+
+/**
+ * @brief Re-renders the page from the collectors' latest values and publishes it
+ * @details Called by the sampler after every cycle in which a collector ran.
+ *          Does nothing unless the server was started.
+ */
+void updateMetricsPage()
+{
+    if (metrics_listen_fd < 0)
+        return;
+
+    metrics_body.clear();
+    addCPU(metrics_body);
+    addMemory(metrics_body);
+    addNetwork(metrics_body);
+    addSensors(metrics_body);
+    addProcesses(metrics_body);
+
+    char header[160];
+    int header_len = snprintf(header, sizeof(header),
+                              "HTTP/1.1 200 OK\r\n"
+                              "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                              "Content-Length: %zu\r\n"
+                              "Connection: close\r\n\r\n",
+                              metrics_body.size());
+
+    // The slot may hold an older page; assign() reuses its capacity
+    string &page = metrics_page.writeBuffer();
+    page.assign(header, header_len);
+    page += metrics_body;
+    metrics_page.publish();
+}
+
+// =============================================================================
+// HTTP SERVER (server thread)
+// =============================================================================
+
+static void sendAll(int fd, const char *data, size_t len)
+{
+    while (len > 0)
+    {
+        ssize_t sent = send(fd, data, len, MSG_NOSIGNAL);
+        if (sent <= 0)
+            return;
+        data += sent;
+        len -= sent;
+    }
+}
+
+/**
+ * @brief Reads one request from @p client and answers it
+ * @details Only `GET /metrics` (or `GET /`) is served; anything else gets a
+ *          short error. Before the first sample the page is still empty and
+ *          the answer is 503.
+ */
+static void serveClient(int client)
+{
+    timeval timeout = {1, 0};
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    // Only the request line matters; read until the end of the headers
+    char request[2048];
+    size_t len = 0;
+    while (len < sizeof(request) - 1)
+    {
+        ssize_t got = recv(client, request + len, sizeof(request) - 1 - len, 0);
+        if (got <= 0)
+            break;
+        len += got;
+        request[len] = '\0';
+        if (strstr(request, "\r\n\r\n") != nullptr || strstr(request, "\n\n") != nullptr)
+            break;
+    }
+    request[len] = '\0';
+
+    static const char not_found[] = "HTTP/1.1 404 Not Found\r\nContent-Type: text/plain\r\n"
+                                    "Content-Length: 23\r\nConnection: close\r\n\r\nTry GET /metrics here.\n";
+    static const char not_ready[] = "HTTP/1.1 503 Service Unavailable\r\nContent-Type: text/plain\r\n"
+                                    "Content-Length: 20\r\nConnection: close\r\n\r\nNo sample taken yet\n";
+
+    if (strncmp(request, "GET /metrics ", 13) != 0 && strncmp(request, "GET / ", 6) != 0 &&
+        strncmp(request, "GET /metrics?", 13) != 0)
+    {
+        sendAll(client, not_found, sizeof(not_found) - 1);
+        return;
+    }
+
+    const string &page = metrics_page.read();
+    if (page.empty())
+    {
+        sendAll(client, not_ready, sizeof(not_ready) - 1);
+        return;
+    }
+    sendAll(client, page.data(), page.size());
+    metrics_scrapes.fetch_add(1, memory_order_relaxed);
+}
+
+/**
+ * @brief Accept loop of the server thread; returns once the wakeup pipe is written
+ */
+static void serveMetrics()
+{
+    pollfd fds[2] = {{metrics_listen_fd, POLLIN, 0}, {metrics_wakeup[0], POLLIN, 0}};
+    while (true)
+    {
+        if (poll(fds, 2, -1) < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        if (fds[1].revents != 0)
+            break;
+        if (fds[0].revents & POLLIN)
+        {
+            int client = accept4(metrics_listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+            if (client < 0)
+                continue;
+            serveClient(client);
+            close(client);
+        }
+    }
+}
+
+// =============================================================================
+// PUBLIC INTERFACE
+// =============================================================================
+
+/**
+ * @brief Listens on 127.0.0.1:@p port and starts the server thread
+ * @return false if the port cannot be bound (errno is set)
+ * @note Call before startSampler(), so the first cycle already renders a page.
+ */
+bool startMetricsServer(int port)
+{
+    stopMetricsServer();
+
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        return false;
+
+    int reuse = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons((uint16_t)port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(fd, (sockaddr *)&address, sizeof(address)) != 0 || listen(fd, 16) != 0 ||
+        pipe2(metrics_wakeup, O_CLOEXEC) != 0)
+    {
+        int saved = errno;
+        close(fd);
+        errno = saved;
+        return false;
+    }
+
+    metrics_listen_fd = fd;
+    metrics_thread = thread(serveMetrics);
+    return true;
+}
+
+/**
+ * @brief Stops the server thread and closes the socket; call after stopSampler()
+ */
+void stopMetricsServer()
+{
+    if (metrics_listen_fd < 0)
+        return;
+
+    char wake = 1;
+    (void)!write(metrics_wakeup[1], &wake, 1);
+    if (metrics_thread.joinable())
+        metrics_thread.join();
+
+    close(metrics_wakeup[0]);
+    close(metrics_wakeup[1]);
+    metrics_wakeup[0] = metrics_wakeup[1] = -1;
+    close(metrics_listen_fd);
+    metrics_listen_fd = -1;
+}
+
+bool metricsServerActive()
+{
+    return metrics_listen_fd >= 0;
+}
+
+uint64_t metricsScrapeCount()
+{
+    return metrics_scrapes.load(memory_order_relaxed);
+}
@@ -2,47 +2,41 @@
  * @file network.cpp
  * @brief Network monitoring implementation for Linux systems
  * @details This file provides functionality to monitor network interfaces,
- *          parse network statistics from /proc/net/dev, and render network
- *          information using ImGui for visualization.
+ *          parse network statistics from /proc/net/dev and publish them
+ *          to the render thread (see network_ui.cpp for the ImGui views).
  * @author Stephen Kisengese
  * @date 2025
  */
 
-#include "header.h"
+#include "collector.h"
 
 // =============================================================================
 // GLOBAL VARIABLES AND STATE MANAGEMENT
 // =============================================================================
 
 /**
- * @brief Global map storing current RX (receive) statistics for all network interfaces
- * @details Maps interface name to RX statistics structure containing bytes, packets, errors, etc.
+ * @brief Network statistics being assembled by the sampler thread
+ * @details parseNetworkDevFile() fills the RX/TX maps and
+ *          getNetworkInterfaces() the interface list; updateNetworkStats()
+ *          then publishes a copy. Only the sampler thread touches this.
  */
-static map<string, RX> current_rx_stats;
+static NetworkSnapshot sampled_network;
 
 /**
- * @brief Global map storing current TX (transmit) statistics for all network interfaces
- * @details Maps interface name to TX statistics structure containing bytes, packets, errors, etc.
+ * @brief Network statistics as published to the render thread
+ * @details Render functions read the latest complete snapshot without
+ *          locking, so a slow /proc/net/dev read never stalls a frame.
  */
-static map<string, TX> current_tx_stats;
+static TripleBuffer<NetworkSnapshot> network_buffer;
 
-/**
- * @brief Global structure storing information about all active network interfaces
- * @details Contains IPv4 addresses and interface names for all detected interfaces
- */
-static Networks current_networks;
-
-/**
- * @brief Mutex for thread-safe access to network statistics data
- * @details Protects concurrent access to current_rx_stats and current_tx_stats
- */
-static mutex network_mutex;
+static map<string, uint64_t> last_rx_bytes; ///< Per-interface RX bytes at the previous store sample
+static map<string, uint64_t> last_tx_bytes; ///< Per-interface TX bytes at the previous store sample
+static chrono::steady_clock::time_point last_byte_sample; ///< When last_rx_bytes/last_tx_bytes were taken
 
-/**
- * @brief Flag indicating whether network data has been successfully parsed and is ready for use
- * @details Set to true after successful parsing of /proc/net/dev, false otherwise
- */
-static bool network_data_ready = false;
+static RollupHistory rx_rate_history; ///< Bytes/s received over all interfaces, sampler thread only
+static RollupHistory tx_rate_history; ///< Bytes/s transmitted over all interfaces, sampler thread only
+static TripleBuffer<RollupHistory> rx_rate_buffer; ///< rx_rate_history as published to the render thread
+static TripleBuffer<RollupHistory> tx_rate_buffer; ///< tx_rate_history as published to the render thread
 
 // =============================================================================
 // NETWORK STATISTICS PARSING
@@ -56,8 +50,8 @@ static bool network_data_ready = false;
  *          - One line per interface with format: "interface: rx_stats tx_stats"
  *          - Each line contains 16 numeric values (8 RX + 8 TX statistics)
  * 
- * @note This function is thread-safe and uses a mutex lock
- * @note Sets network_data_ready to true upon successful parsing
+ * @note Sampler thread only; call updateNetworkStats() to publish the result
+ * @note Marks the sampled data ready upon successful parsing
  * @note Clears previous statistics before parsing new data
  * 
  * @warning Requires read access to /proc/net/dev (typically available to all users)
@@ -84,13 +78,13 @@ static bool network_data_ready = false;
  */
 void parseNetworkDevFile()
 {
-    lock_guard<mutex> lock(network_mutex);
-
-    ifstream file("/proc/net/dev");
-    if (!file.is_open())
+    TRACE_ZONE("parseNetworkDevFile");
+    string contents;
+    if (!readSourceFile("/proc/net/dev", contents))
     {
         return;
     }
+    istringstream file(contents);
 
     string line;
     // Skip header lines (contain column descriptions)
@@ -98,8 +92,8 @@ void parseNetworkDevFile()
     getline(file, line);
 
     // Clear previous statistics
-    current_rx_stats.clear();
-    current_tx_stats.clear();
+    sampled_network.rx.clear();
+    sampled_network.tx.clear();
 
     while (getline(file, line))
     {
@@ -117,47 +111,28 @@ void parseNetworkDevFile()
         string interface_name = line.substr(0, colon_pos);
         string stats_line = line.substr(colon_pos + 1);
 
-        // Parse numeric statistics from the line
+        // Parse the 16 statistics straight into the 64-bit counters; the
+        // kernel reports them as unsigned 64-bit values
         istringstream iss(stats_line);
-        vector<long long> values;
-        long long value;
-
-        while (iss >> value)
+        RX rx_stats;
+        TX tx_stats;
+
+        // RX statistics (first 8 values)
+        iss >> rx_stats.bytes >> rx_stats.packets >> rx_stats.errs >> rx_stats.drop >> rx_stats.fifo >>
+            rx_stats.frame >> rx_stats.compressed >> rx_stats.multicast;
+        // TX statistics (next 8 values)
+        iss >> tx_stats.bytes >> tx_stats.packets >> tx_stats.errs >> tx_stats.drop >> tx_stats.fifo >>
+            tx_stats.colls >> tx_stats.carrier >> tx_stats.compressed;
+
+        // Keep only interfaces with all 16 required statistics values
+        if (iss)
         {
-            values.push_back(value);
-        }
-
-        // Ensure we have all 16 required statistics values
-        if (values.size() >= 16)
-        {
-            // RX statistics (first 8 values)
-            RX rx_stats;
-            rx_stats.bytes = values[0];
-            rx_stats.packets = values[1];
-            rx_stats.errs = values[2];
-            rx_stats.drop = values[3];
-            rx_stats.fifo = values[4];
-            rx_stats.frame = values[5];
-            rx_stats.compressed = values[6];
-            rx_stats.multicast = values[7];
-            current_rx_stats[interface_name] = rx_stats;
-
-            // TX statistics (next 8 values)
-            TX tx_stats;
-            tx_stats.bytes = values[8];
-            tx_stats.packets = values[9];
-            tx_stats.errs = values[10];
-            tx_stats.drop = values[11];
-            tx_stats.fifo = values[12];
-            tx_stats.colls = values[13];
-            tx_stats.carrier = values[14];
-            tx_stats.compressed = values[15];
-            current_tx_stats[interface_name] = tx_stats;
+            sampled_network.rx[interface_name] = rx_stats;
+            sampled_network.tx[interface_name] = tx_stats;
         }
     }
 
-    file.close();
-    network_data_ready = true;
+    sampled_network.ready = true;
 }
 
 // =============================================================================
@@ -167,24 +142,22 @@ void parseNetworkDevFile()
 /**
  * @brief Get all network interfaces with their IPv4 addresses
  * @details Uses getifaddrs() system call to enumerate all network interfaces
- *          and extract their IPv4 addresses. Updates the global current_networks
- *          structure with the discovered interfaces.
+ *          and extract their IPv4 addresses. Also stores them in the sampled
+ *          network statistics published by updateNetworkStats().
  * 
  * @return Networks structure containing all discovered IPv4 interfaces
  * @retval Networks.ip4s Vector of IP4 structures with interface names and addresses
  * 
  * @note Only IPv4 addresses are collected (AF_INET family)
  * @note Skips interfaces without addresses (ifa_addr == NULL)
- * @note Memory for interface names is allocated with strdup() - ensure proper cleanup
- * @note Updates global current_networks variable as side effect
+ * @note Sampler thread only (updates the sampled network statistics)
  * 
  * @warning Caller should handle the case where getifaddrs() fails
- * @warning Memory allocated for IP4.name should be freed when no longer needed
  * 
  * @example
  * Networks nets = getNetworkInterfaces();
  * for (const auto& ip4 : nets.ip4s) {
- *     printf("Interface: %s, Address: %s\n", ip4.name, ip4.addressBuffer);
+ *     printf("Interface: %s, Address: %s\n", ip4.name.c_str(), ip4.addressBuffer);
  * }
  */
 Networks getNetworkInterfaces()
@@ -195,7 +168,8 @@ Networks getNetworkInterfaces()
     struct ifaddrs *ifaddr, *ifa;
     char addressBuffer[INET_ADDRSTRLEN];
 
-    // Get linked list of interface addresses
+    // Get linked list of interface addresses (a netlink socket and two dumps, about 9 syscalls)
+    countCollectorIo(9);
     if (getifaddrs(&ifaddr) == -1)
     {
         return networks;
@@ -215,7 +189,7 @@ Networks getNetworkInterfaces()
 
             // Create IP4 structure and add to networks
             IP4 ip4;
-            ip4.name = strdup(ifa->ifa_name);
+            ip4.name = ifa->ifa_name;
             strcpy(ip4.addressBuffer, addressBuffer);
             networks.ip4s.push_back(ip4);
         }
@@ -223,10 +197,135 @@ Networks getNetworkInterfaces()
 
     // Clean up system resources
     freeifaddrs(ifaddr);
-    current_networks = networks;
+
+    sampled_network.networks = networks;
     return networks;
 }
 
+/**
+ * @brief Bytes moved over all interfaces since @p previous was taken
+ * @param now Counters just parsed from /proc/net/dev
+ * @param previous Per-interface byte counters of the last call; updated
+ * @details Only interfaces present in both readings count, and a counter
+ *          that went backwards (driver reset) adds nothing, so interfaces
+ *          coming and going do not show up as spikes.
+ */
+template <typename Stats>
+static uint64_t interfaceByteDelta(const map<string, Stats> &now, map<string, uint64_t> &previous)
+{
+    uint64_t delta = 0;
+    for (const auto &pair : now)
+    {
+        auto it = previous.find(pair.first);
+        if (it == previous.end())
+        {
+            previous.emplace(pair.first, pair.second.bytes);
+            continue;
+        }
+        if (pair.second.bytes >= it->second)
+            delta += pair.second.bytes - it->second;
+        it->second = pair.second.bytes;
+    }
+    for (auto it = previous.begin(); it != previous.end();)
+    {
+        if (now.count(it->first) == 0)
+            it = previous.erase(it);
+        else
+            ++it;
+    }
+    return delta;
+}
+
+/**
+ * @brief Refreshes interface statistics and addresses and publishes them
+ * @details Called by the sampler thread. The render functions in
+ *          network_ui.cpp pick up the new snapshot on their next frame.
+ */
+void updateNetworkStats()
+{
+    parseNetworkDevFile();
+    getNetworkInterfaces();
+
+    // Throughput over all interfaces goes to the graphs and the persistent
+    // store. The cumulative totals would not survive the float records: past
+    // 2^24 bytes they round to ever larger steps.
+    auto now = chrono::steady_clock::now();
+    bool first_sample = last_rx_bytes.empty() && last_tx_bytes.empty();
+    uint64_t rx_delta = interfaceByteDelta(sampled_network.rx, last_rx_bytes);
+    uint64_t tx_delta = interfaceByteDelta(sampled_network.tx, last_tx_bytes);
+    double elapsed_s = chrono::duration<double>(now - last_byte_sample).count();
+    last_byte_sample = now;
+    if (!first_sample && elapsed_s > 0.0)
+    {
+        float rx_rate = (float)(rx_delta / elapsed_s);
+        float tx_rate = (float)(tx_delta / elapsed_s);
+        rx_rate_history.push(rx_rate, now);
+        tx_rate_history.push(tx_rate, now);
+        appendMetric(STORE_NET_RX, rx_rate);
+        appendMetric(STORE_NET_TX, tx_rate);
+
+        rx_rate_buffer.writeBuffer() = rx_rate_history;
+        rx_rate_buffer.publish();
+        tx_rate_buffer.writeBuffer() = tx_rate_history;
+        tx_rate_buffer.publish();
+    }
+
+    network_buffer.writeBuffer() = sampled_network;
+    network_buffer.publish();
+}
+
+/**
+ * @brief Reloads the throughput histories from the metric store
+ * @param max_age Oldest sample worth replaying
+ * @note Called by restoreHistories() before the sampler thread starts
+ */
+void restoreNetworkHistories(chrono::seconds max_age)
+{
+    restoreMetricHistory(STORE_NET_RX, rx_rate_history, max_age);
+    rx_rate_buffer.writeBuffer() = rx_rate_history;
+    rx_rate_buffer.publish();
+
+    restoreMetricHistory(STORE_NET_TX, tx_rate_history, max_age);
+    tx_rate_buffer.writeBuffer() = tx_rate_history;
+    tx_rate_buffer.publish();
+}
+
+/**
+ * @brief Receive throughput history (bytes/s) as last published by updateNetworkStats()
+ * @note Render thread only; the reference stays valid until the next call
+ */
+const RollupHistory &getNetworkRXHistory()
+{
+    return rx_rate_buffer.read();
+}
+
+/**
+ * @brief Transmit throughput history (bytes/s) as last published by updateNetworkStats()
+ * @note Render thread only; the reference stays valid until the next call
+ */
+const RollupHistory &getNetworkTXHistory()
+{
+    return tx_rate_buffer.read();
+}
+
+/**
+ * @brief Latest network statistics published by updateNetworkStats()
+ * @note Render thread only; the reference stays valid until the next call
+ */
+const NetworkSnapshot &getNetworkSnapshot()
+{
+    return network_buffer.read();
+}
+
+/**
+ * @brief Network statistics assembled by the last updateNetworkStats()
+ * @note Sampler thread only, like latestProcessSnapshot()
+ */
+const NetworkSnapshot &latestNetworkSnapshot()
+{
+    return sampled_network;
+}
+
 // =============================================================================
 // UTILITY FUNCTIONS FOR DATA FORMATTING
 // =============================================================================
@@ -315,318 +414,6 @@ float calculateNetworkProgress(uint64_t bytes)
     return (float)bytes / (float)max_scale;
 }
 
-// =============================================================================
-// IMGUI RENDERING FUNCTIONS
-// =============================================================================
-
-/**
- * @brief Render network interfaces list in ImGui collapsible header
- * @details Creates a two-column table showing interface names and their
- *          corresponding IPv4 addresses. Uses ImGui::CollapsingHeader for
- *          space-efficient display.
- * 
- * @note Requires current_networks to be populated via getNetworkInterfaces()
- * @note Creates a collapsible section titled "Network Interfaces"
- * @note Uses ImGui::Columns for tabular layout
- * 
- * @warning Must be called within an ImGui rendering context
- * @warning Assumes current_networks.ip4s is valid and populated
- * 
- * Layout:
- * - Column 1: Interface name (e.g., "eth0", "wlan0")
- * - Column 2: IPv4 address (e.g., "192.168.1.100")
- */
-void renderNetworkInterfaces()
-{
-    if (ImGui::CollapsingHeader("Network Interfaces"))
-    {
-        ImGui::Columns(2, "NetworkInterfaces", true);
-        ImGui::Text("Interface");
-        ImGui::NextColumn();
-        ImGui::Text("IPv4 Address");
-        ImGui::NextColumn();
-        ImGui::Separator();
-
-        for (const auto &ip4 : current_networks.ip4s)
-        {
-            ImGui::Text("%s", ip4.name);
-            ImGui::NextColumn();
-            ImGui::Text("%s", ip4.addressBuffer);
-            ImGui::NextColumn();
-        }
-
-        ImGui::Columns(1);
-    }
-}
-
-/**
- * @brief Render RX (receive) statistics in an ImGui table
- * @details Creates a comprehensive table showing all receive statistics
- *          for each network interface. Includes byte formatting for
- *          human-readable display.
- * 
- * @note Requires network_data_ready to be true (call parseNetworkDevFile() first)
- * @note Thread-safe with mutex locking
- * @note Returns early if network data is not ready
- * 
- * @warning Must be called within an ImGui rendering context
- * @warning Requires parseNetworkDevFile() to be called beforehand
- * 
- * Table Columns:
- * - Interface: Network interface name
- * - Bytes: Total bytes received (formatted with units)
- * - Packets: Total packets received
- * - Errs: Receive errors
- * - Drop: Dropped packets
- * - Fifo: FIFO buffer errors
- * - Frame: Frame alignment errors
- * - Compressed: Compressed packets
- * - Multicast: Multicast packets
- * 
- * Features:
- * - Scrollable table with borders
- * - Resizable columns
- * - Automatic byte formatting (B, KB, MB, GB)
- */
-void renderRXTable()
-{
-    if (!network_data_ready)
-        return;
-
-    lock_guard<mutex> lock(network_mutex);
-
-    if (ImGui::BeginTable("RX_Table", 9, ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY))
-    {
-        ImGui::TableSetupColumn("Interface");
-        ImGui::TableSetupColumn("Bytes");
-        ImGui::TableSetupColumn("Packets");
-        ImGui::TableSetupColumn("Errs");
-        ImGui::TableSetupColumn("Drop");
-        ImGui::TableSetupColumn("Fifo");
-        ImGui::TableSetupColumn("Frame");
-        ImGui::TableSetupColumn("Compressed");
-        ImGui::TableSetupColumn("Multicast");
-        ImGui::TableHeadersRow();
-
-        for (const auto &pair : current_rx_stats)
-        {
-            const string &interface = pair.first;
-            const RX &stats = pair.second;
-
-            ImGui::TableNextRow();
-            ImGui::TableSetColumnIndex(0);
-            ImGui::Text("%s", interface.c_str());
-            ImGui::TableSetColumnIndex(1);
-            ImGui::Text("%s", formatNetworkBytes(stats.bytes).c_str());
-            ImGui::TableSetColumnIndex(2);
-            ImGui::Text("%d", stats.packets);
-            ImGui::TableSetColumnIndex(3);
-            ImGui::Text("%d", stats.errs);
-            ImGui::TableSetColumnIndex(4);
-            ImGui::Text("%d", stats.drop);
-            ImGui::TableSetColumnIndex(5);
-            ImGui::Text("%d", stats.fifo);
-            ImGui::TableSetColumnIndex(6);
-            ImGui::Text("%d", stats.frame);
-            ImGui::TableSetColumnIndex(7);
-            ImGui::Text("%d", stats.compressed);
-            ImGui::TableSetColumnIndex(8);
-            ImGui::Text("%d", stats.multicast);
-        }
-
-        ImGui::EndTable();
-    }
-}
-
-/**
- * @brief Render TX (transmit) statistics in an ImGui table
- * @details Creates a comprehensive table showing all transmit statistics
- *          for each network interface. Similar to RX table but with
- *          TX-specific columns.
- * 
- * @note Requires network_data_ready to be true (call parseNetworkDevFile() first)
- * @note Thread-safe with mutex locking
- * @note Returns early if network data is not ready
- * 
- * @warning Must be called within an ImGui rendering context
- * @warning Requires parseNetworkDevFile() to be called beforehand
- * 
- * Table Columns:
- * - Interface: Network interface name
- * - Bytes: Total bytes transmitted (formatted with units)
- * - Packets: Total packets transmitted
- * - Errs: Transmit errors
- * - Drop: Dropped packets
- * - Fifo: FIFO buffer errors
- * - Colls: Collision count
- * - Carrier: Carrier losses
- * - Compressed: Compressed packets
- * 
- * Features:
- * - Scrollable table with borders
- * - Resizable columns
- * - Automatic byte formatting (B, KB, MB, GB)
- */
-void renderTXTable()
-{
-    if (!network_data_ready)
-        return;
-
-    lock_guard<mutex> lock(network_mutex);
-
-    if (ImGui::BeginTable("TX_Table", 9, ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY))
-    {
-        ImGui::TableSetupColumn("Interface");
-        ImGui::TableSetupColumn("Bytes");
-        ImGui::TableSetupColumn("Packets");
-        ImGui::TableSetupColumn("Errs");
-        ImGui::TableSetupColumn("Drop");
-        ImGui::TableSetupColumn("Fifo");
-        ImGui::TableSetupColumn("Colls");
-        ImGui::TableSetupColumn("Carrier");
-        ImGui::TableSetupColumn("Compressed");
-        ImGui::TableHeadersRow();
-
-        for (const auto &pair : current_tx_stats)
-        {
-            const string &interface = pair.first;
-            const TX &stats = pair.second;
-
-            ImGui::TableNextRow();
-            ImGui::TableSetColumnIndex(0);
-            ImGui::Text("%s", interface.c_str());
-            ImGui::TableSetColumnIndex(1);
-            ImGui::Text("%s", formatNetworkBytes(stats.bytes).c_str());
-            ImGui::TableSetColumnIndex(2);
-            ImGui::Text("%d", stats.packets);
-            ImGui::TableSetColumnIndex(3);
-            ImGui::Text("%d", stats.errs);
-            ImGui::TableSetColumnIndex(4);
-            ImGui::Text("%d", stats.drop);
-            ImGui::TableSetColumnIndex(5);
-            ImGui::Text("%d", stats.fifo);
-            ImGui::TableSetColumnIndex(6);
-            ImGui::Text("%d", stats.colls);
-            ImGui::TableSetColumnIndex(7);
-            ImGui::Text("%d", stats.carrier);
-            ImGui::TableSetColumnIndex(8);
-            ImGui::Text("%d", stats.compressed);
-        }
-
-        ImGui::EndTable();
-    }
-}
-
-/**
- * @brief Render RX (receive) usage as progress bars
- * @details Creates visual progress bars for each network interface showing
- *          receive usage as a percentage of a 2GB scale. Uses green color
- *          to indicate incoming traffic.
- * 
- * @note Requires network_data_ready to be true (call parseNetworkDevFile() first)
- * @note Thread-safe with mutex locking
- * @note Returns early if network data is not ready
- * 
- * @warning Must be called within an ImGui rendering context
- * @warning Requires parseNetworkDevFile() to be called beforehand
- * 
- * Visual Features:
- * - Green progress bars (RGB: 0.2, 0.8, 0.2) for incoming traffic
- * - Progress scale: 0 to 2GB (100%)
- * - Text overlay showing "current usage / 2GB"
- * - Interface name displayed alongside each bar
- * - Full-width progress bars
- * 
- * Layout:
- * - Section title: "RX (Incoming) Network Usage:"
- * - Separator line
- * - One progress bar per interface
- * - Interface name on the left, progress bar fills remaining width
- */
-void renderRXUsageBars()
-{
-    if (!network_data_ready)
-        return;
-
-    lock_guard<mutex> lock(network_mutex);
-
-    ImGui::Text("RX (Incoming) Network Usage:");
-    ImGui::Separator();
-
-    for (const auto &pair : current_rx_stats)
-    {
-        const string &interface = pair.first;
-        const RX &stats = pair.second;
-
-        float progress = calculateNetworkProgress(stats.bytes);
-        string usage_text = formatNetworkBytes(stats.bytes) + " / 2GB";
-
-        ImGui::Text("%s", interface.c_str());
-        ImGui::SameLine();
-        ImGui::SetNextItemWidth(-1);
-
-        // Use green color for RX (incoming traffic)
-        ImGui::PushStyleColor(ImGuiCol_PlotHistogram, ImVec4(0.2f, 0.8f, 0.2f, 1.0f));
-        ImGui::ProgressBar(progress, ImVec2(0.0f, 0.0f), usage_text.c_str());
-        ImGui::PopStyleColor();
-    }
-}
-
-/**
- * @brief Render TX (transmit) usage as progress bars
- * @details Creates visual progress bars for each network interface showing
- *          transmit usage as a percentage of a 2GB scale. Uses blue color
- *          to indicate outgoing traffic.
- * 
- * @note Requires network_data_ready to be true (call parseNetworkDevFile() first)
- * @note Thread-safe with mutex locking
- * @note Returns early if network data is not ready
- * 
- * @warning Must be called within an ImGui rendering context
- * @warning Requires parseNetworkDevFile() to be called beforehand
- * 
- * Visual Features:
- * - Blue progress bars (RGB: 0.2, 0.2, 0.8) for outgoing traffic
- * - Progress scale: 0 to 2GB (100%)
- * - Text overlay showing "current usage / 2GB"
- * - Interface name displayed alongside each bar
- * - Full-width progress bars
- * 
- * Layout:
- * - Section title: "TX (Outgoing) Network Usage:"
- * - Separator line
- * - One progress bar per interface
- * - Interface name on the left, progress bar fills remaining width
- */
-void renderTXUsageBars()
-{
-    if (!network_data_ready)
-        return;
-
-    lock_guard<mutex> lock(network_mutex);
-
-    ImGui::Text("TX (Outgoing) Network Usage:");
-    ImGui::Separator();
-
-    for (const auto &pair : current_tx_stats)
-    {
-        const string &interface = pair.first;
-        const TX &stats = pair.second;
-
-        float progress = calculateNetworkProgress(stats.bytes);
-        string usage_text = formatNetworkBytes(stats.bytes) + " / 2GB";
-
-        ImGui::Text("%s", interface.c_str());
-        ImGui::SameLine();
-        ImGui::SetNextItemWidth(-1);
-
-        // Use blue color for TX (outgoing traffic)
-        ImGui::PushStyleColor(ImGuiCol_PlotHistogram, ImVec4(0.2f, 0.2f, 0.8f, 1.0f));
-        ImGui::ProgressBar(progress, ImVec2(0.0f, 0.0f), usage_text.c_str());
-        ImGui::PopStyleColor();
-    }
-}
-
 // =============================================================================
 // USAGE EXAMPLE AND INTEGRATION NOTES
 // =============================================================================
@@ -634,15 +421,12 @@ void renderTXUsageBars()
 /*
  * TYPICAL USAGE PATTERN:
  * 
- * 1. Initialize network monitoring:
- *    Networks networks = getNetworkInterfaces();
- *    parseNetworkDevFile();
+ * 1. Collect and publish network data (sampler thread):
+ *    updateNetworkStats();
  * 
- * 2. In your main loop (ImGui render loop):
- *    // Update network data periodically
- *    parseNetworkDevFile();
- *    
- *    // Render network information
+ * 2. Let the sampler thread refresh the data (see sampler.cpp), then
+ *    in your main loop (ImGui render loop):
+ *    // Render network information (network_ui.cpp)
  *    renderNetworkInterfaces();
  *    renderRXTable();
  *    renderTXTable();
@@ -650,17 +434,17 @@ void renderTXUsageBars()
  *    renderTXUsageBars();
  * 
  * 3. Performance considerations:
- *    - parseNetworkDevFile() should be called periodically (e.g., every 1-2 seconds)
+ *    - updateNetworkStats() should be called periodically (e.g., every 1-2 seconds)
  *    - Rendering functions can be called every frame
  *    - Use ImGui::CollapsingHeader to hide unused sections
  * 
  * THREAD SAFETY:
- * - All functions are thread-safe through mutex locking
- * - parseNetworkDevFile() can be called from a background thread
+ * - Collection functions run on the sampler thread only
+ * - Snapshots are handed over through a lock-free TripleBuffer
  * - Rendering functions must be called from the main ImGui thread
  * 
  * MEMORY MANAGEMENT:
- * - IP4.name strings are allocated with strdup() and should be freed
+ * - IP4.name strings are owned by the IP4 entries
  * - Global maps are automatically managed
  * - No manual cleanup required for statistics data
  * 
@@ -672,6 +456,6 @@ void renderTXUsageBars()
  * PLATFORM REQUIREMENTS:
  * - Linux system with /proc/net/dev support
  * - POSIX-compliant system for getifaddrs()
- * - ImGui library for rendering functions
+ * - ImGui library for the rendering functions in network_ui.cpp only
  * - C++11 or later for mutex and threading support
  */
\ No newline at end of file
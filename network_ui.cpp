@@ -0,0 +1,352 @@
+/**
+ * @file network_ui.cpp
+ * @brief ImGui views of the network collector
+ * @details Renders interface addresses, RX/TX counter tables, usage bars and
+ *          throughput graphs from the snapshot and histories published by
+ *          updateNetworkStats() (network.cpp).
+ * @author Stephen Kisengese
+ * @date 2025
+ */
+
+#include "header.h"
+
+// =============================================================================
+// IMGUI RENDERING FUNCTIONS
+// =============================================================================
+
+/**
+ * @brief Render network interfaces list in ImGui collapsible header
+ * @details Creates a two-column table showing interface names and their
+ *          corresponding IPv4 addresses. Uses ImGui::CollapsingHeader for
+ *          space-efficient display.
+ * 
+ * @note Requires updateNetworkStats() to have published interface addresses
+ * @note Creates a collapsible section titled "Network Interfaces"
+ * @note Uses ImGui::Columns for tabular layout
+ * 
+ * @warning Must be called within an ImGui rendering context
+ * 
+ * Layout:
+ * - Column 1: Interface name (e.g., "eth0", "wlan0")
+ * - Column 2: IPv4 address (e.g., "192.168.1.100")
+ */
+void renderNetworkInterfaces()
+{
+    if (ImGui::CollapsingHeader("Network Interfaces"))
+    {
+        const NetworkSnapshot &network = getNetworkSnapshot();
+
+        ImGui::Columns(2, "NetworkInterfaces", true);
+        ImGui::Text("Interface");
+        ImGui::NextColumn();
+        ImGui::Text("IPv4 Address");
+        ImGui::NextColumn();
+        ImGui::Separator();
+
+        for (const auto &ip4 : network.networks.ip4s)
+        {
+            ImGui::TextUnformatted(ip4.name.c_str());
+            ImGui::NextColumn();
+            ImGui::Text("%s", ip4.addressBuffer);
+            ImGui::NextColumn();
+        }
+
+        ImGui::Columns(1);
+    }
+}
+
+/**
+ * @brief Render RX (receive) statistics in an ImGui table
+ * @details Creates a comprehensive table showing all receive statistics
+ *          for each network interface. Includes byte formatting for
+ *          human-readable display.
+ * 
+ * @note Draws nothing until the sampler has published network data
+ * @note Render thread only; reads the latest published snapshot
+ * @note Returns early if network data is not ready
+ * 
+ * @warning Must be called within an ImGui rendering context
+ * @warning Requires updateNetworkStats() to have run at least once
+ * 
+ * Table Columns:
+ * - Interface: Network interface name
+ * - Bytes: Total bytes received (formatted with units)
+ * - Packets: Total packets received
+ * - Errs: Receive errors
+ * - Drop: Dropped packets
+ * - Fifo: FIFO buffer errors
+ * - Frame: Frame alignment errors
+ * - Compressed: Compressed packets
+ * - Multicast: Multicast packets
+ * 
+ * Features:
+ * - Scrollable table with borders
+ * - Resizable columns
+ * - Automatic byte formatting (B, KB, MB, GB)
+ */
+void renderRXTable()
+{
+    const NetworkSnapshot &network = getNetworkSnapshot();
+    if (!network.ready)
+        return;
+
+    if (ImGui::BeginTable("RX_Table", 9, ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY))
+    {
+        ImGui::TableSetupColumn("Interface");
+        ImGui::TableSetupColumn("Bytes");
+        ImGui::TableSetupColumn("Packets");
+        ImGui::TableSetupColumn("Errs");
+        ImGui::TableSetupColumn("Drop");
+        ImGui::TableSetupColumn("Fifo");
+        ImGui::TableSetupColumn("Frame");
+        ImGui::TableSetupColumn("Compressed");
+        ImGui::TableSetupColumn("Multicast");
+        ImGui::TableHeadersRow();
+
+        for (const auto &pair : network.rx)
+        {
+            const string &interface = pair.first;
+            const RX &stats = pair.second;
+
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0);
+            ImGui::Text("%s", interface.c_str());
+            ImGui::TableSetColumnIndex(1);
+            ImGui::Text("%s", formatNetworkBytes(stats.bytes).c_str());
+            ImGui::TableSetColumnIndex(2);
+            ImGui::Text("%llu", (unsigned long long)stats.packets);
+            ImGui::TableSetColumnIndex(3);
+            ImGui::Text("%llu", (unsigned long long)stats.errs);
+            ImGui::TableSetColumnIndex(4);
+            ImGui::Text("%llu", (unsigned long long)stats.drop);
+            ImGui::TableSetColumnIndex(5);
+            ImGui::Text("%llu", (unsigned long long)stats.fifo);
+            ImGui::TableSetColumnIndex(6);
+            ImGui::Text("%llu", (unsigned long long)stats.frame);
+            ImGui::TableSetColumnIndex(7);
+            ImGui::Text("%llu", (unsigned long long)stats.compressed);
+            ImGui::TableSetColumnIndex(8);
+            ImGui::Text("%llu", (unsigned long long)stats.multicast);
+        }
+
+        ImGui::EndTable();
+    }
+}
+
+/**
+ * @brief Render TX (transmit) statistics in an ImGui table
+ * @details Creates a comprehensive table showing all transmit statistics
+ *          for each network interface. Similar to RX table but with
+ *          TX-specific columns.
+ * 
+ * @note Draws nothing until the sampler has published network data
+ * @note Render thread only; reads the latest published snapshot
+ * @note Returns early if network data is not ready
+ * 
+ * @warning Must be called within an ImGui rendering context
+ * @warning Requires updateNetworkStats() to have run at least once
+ * 
+ * Table Columns:
+ * - Interface: Network interface name
+ * - Bytes: Total bytes transmitted (formatted with units)
+ * - Packets: Total packets transmitted
+ * - Errs: Transmit errors
+ * - Drop: Dropped packets
+ * - Fifo: FIFO buffer errors
+ * - Colls: Collision count
+ * - Carrier: Carrier losses
+ * - Compressed: Compressed packets
+ * 
+ * Features:
+ * - Scrollable table with borders
+ * - Resizable columns
+ * - Automatic byte formatting (B, KB, MB, GB)
+ */
+void renderTXTable()
+{
+    const NetworkSnapshot &network = getNetworkSnapshot();
+    if (!network.ready)
+        return;
+
+    if (ImGui::BeginTable("TX_Table", 9, ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY))
+    {
+        ImGui::TableSetupColumn("Interface");
+        ImGui::TableSetupColumn("Bytes");
+        ImGui::TableSetupColumn("Packets");
+        ImGui::TableSetupColumn("Errs");
+        ImGui::TableSetupColumn("Drop");
+        ImGui::TableSetupColumn("Fifo");
+        ImGui::TableSetupColumn("Colls");
+        ImGui::TableSetupColumn("Carrier");
+        ImGui::TableSetupColumn("Compressed");
+        ImGui::TableHeadersRow();
+
+        for (const auto &pair : network.tx)
+        {
+            const string &interface = pair.first;
+            const TX &stats = pair.second;
+
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0);
+            ImGui::Text("%s", interface.c_str());
+            ImGui::TableSetColumnIndex(1);
+            ImGui::Text("%s", formatNetworkBytes(stats.bytes).c_str());
+            ImGui::TableSetColumnIndex(2);
+            ImGui::Text("%llu", (unsigned long long)stats.packets);
+            ImGui::TableSetColumnIndex(3);
+            ImGui::Text("%llu", (unsigned long long)stats.errs);
+            ImGui::TableSetColumnIndex(4);
+            ImGui::Text("%llu", (unsigned long long)stats.drop);
+            ImGui::TableSetColumnIndex(5);
+            ImGui::Text("%llu", (unsigned long long)stats.fifo);
+            ImGui::TableSetColumnIndex(6);
+            ImGui::Text("%llu", (unsigned long long)stats.colls);
+            ImGui::TableSetColumnIndex(7);
+            ImGui::Text("%llu", (unsigned long long)stats.carrier);
+            ImGui::TableSetColumnIndex(8);
+            ImGui::Text("%llu", (unsigned long long)stats.compressed);
+        }
+
+        ImGui::EndTable();
+    }
+}
+
+/**
+ * @brief Render RX (receive) usage as progress bars
+ * @details Creates visual progress bars for each network interface showing
+ *          receive usage as a percentage of a 2GB scale. Uses green color
+ *          to indicate incoming traffic.
+ * 
+ * @note Draws nothing until the sampler has published network data
+ * @note Render thread only; reads the latest published snapshot
+ * @note Returns early if network data is not ready
+ * 
+ * @warning Must be called within an ImGui rendering context
+ * @warning Requires updateNetworkStats() to have run at least once
+ * 
+ * Visual Features:
+ * - Green progress bars (RGB: 0.2, 0.8, 0.2) for incoming traffic
+ * - Progress scale: 0 to 2GB (100%)
+ * - Text overlay showing "current usage / 2GB"
+ * - Interface name displayed alongside each bar
+ * - Full-width progress bars
+ * 
+ * Layout:
+ * - Section title: "RX (Incoming) Network Usage:"
+ * - Separator line
+ * - One progress bar per interface
+ * - Interface name on the left, progress bar fills remaining width
+ */
+void renderRXUsageBars()
+{
+    const NetworkSnapshot &network = getNetworkSnapshot();
+    if (!network.ready)
+        return;
+
+    ImGui::Text("RX (Incoming) Network Usage:");
+    ImGui::Separator();
+
+    for (const auto &pair : network.rx)
+    {
+        const string &interface = pair.first;
+        const RX &stats = pair.second;
+
+        float progress = calculateNetworkProgress(stats.bytes);
+        string usage_text = formatNetworkBytes(stats.bytes) + " / 2GB";
+
+        ImGui::Text("%s", interface.c_str());
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(-1);
+
+        // Use green color for RX (incoming traffic)
+        ImGui::PushStyleColor(ImGuiCol_PlotHistogram, ImVec4(0.2f, 0.8f, 0.2f, 1.0f));
+        ImGui::ProgressBar(progress, ImVec2(0.0f, 0.0f), usage_text.c_str());
+        ImGui::PopStyleColor();
+    }
+}
+
+/**
+ * @brief Render TX (transmit) usage as progress bars
+ * @details Creates visual progress bars for each network interface showing
+ *          transmit usage as a percentage of a 2GB scale. Uses blue color
+ *          to indicate outgoing traffic.
+ * 
+ * @note Draws nothing until the sampler has published network data
+ * @note Render thread only; reads the latest published snapshot
+ * @note Returns early if network data is not ready
+ * 
+ * @warning Must be called within an ImGui rendering context
+ * @warning Requires updateNetworkStats() to have run at least once
+ * 
+ * Visual Features:
+ * - Blue progress bars (RGB: 0.2, 0.2, 0.8) for outgoing traffic
+ * - Progress scale: 0 to 2GB (100%)
+ * - Text overlay showing "current usage / 2GB"
+ * - Interface name displayed alongside each bar
+ * - Full-width progress bars
+ * 
+ * Layout:
+ * - Section title: "TX (Outgoing) Network Usage:"
+ * - Separator line
+ * - One progress bar per interface
+ * - Interface name on the left, progress bar fills remaining width
+ */
+void renderTXUsageBars()
+{
+    const NetworkSnapshot &network = getNetworkSnapshot();
+    if (!network.ready)
+        return;
+
+    ImGui::Text("TX (Outgoing) Network Usage:");
+    ImGui::Separator();
+
+    for (const auto &pair : network.tx)
+    {
+        const string &interface = pair.first;
+        const TX &stats = pair.second;
+
+        float progress = calculateNetworkProgress(stats.bytes);
+        string usage_text = formatNetworkBytes(stats.bytes) + " / 2GB";
+
+        ImGui::Text("%s", interface.c_str());
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(-1);
+
+        // Use blue color for TX (outgoing traffic)
+        ImGui::PushStyleColor(ImGuiCol_PlotHistogram, ImVec4(0.2f, 0.2f, 0.8f, 1.0f));
+        ImGui::ProgressBar(progress, ImVec2(0.0f, 0.0f), usage_text.c_str());
+        ImGui::PopStyleColor();
+    }
+}
+
+/**
+ * @brief Render receive and transmit throughput graphs over all interfaces
+ * @details Plots the bytes/s histories kept by updateNetworkStats(). With
+ *          --store they are reloaded on startup, so the graphs continue
+ *          where the previous run stopped. The Y axis scales to the data.
+ */
+void renderThroughputGraphs()
+{
+    static int throughput_window = 0; ///< Selected graph window (see history_ui.cpp)
+
+    ImGui::Text("Window:");
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(150);
+    renderHistoryWindowCombo("##net_window", throughput_window);
+
+    const RollupHistory *const histories[] = {&getNetworkRXHistory(), &getNetworkTXHistory()};
+    const char *const labels[] = {"Received", "Transmitted"};
+    const char *const ids[] = {"##rx_rate_graph", "##tx_rate_graph"};
+    for (int i = 0; i < 2; i++)
+    {
+        const RollupHistory &history = *histories[i];
+        if (history.raw().empty())
+        {
+            ImGui::Text("%s: collecting data...", labels[i]);
+            continue;
+        }
+        ImGui::Text("%s: %s/s", labels[i], formatNetworkBytes((uint64_t)history.raw().back()).c_str());
+        ImVec2 size(ImGui::GetContentRegionAvail().x, 120.0f);
+        renderHistoryPlot(ids[i], history, throughput_window, FLT_MAX, size);
+    }
+}
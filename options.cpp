@@ -0,0 +1,199 @@
+/**
+ * @file options.cpp
+ * @brief Command line options and collection start-up shared by every front end
+ * @details The GUI (main.cpp) and the headless collector (headless.cpp) accept
+ *          the same collector options and start and stop collection the same
+ *          way, so both go through this file: parseArguments() fills in the
+ *          option globals, selectDataSource() installs the --root / --replay
+ *          backend, and startCollection() / stopCollection() bracket the
+ *          sampler with the metric store, the trace recorder and the
+ *          metrics endpoint.
+ * @author Stephen Kisengese
+ * @date 2025
+ */
+
+#include "collector.h"
+
+// =============================================================================
+// OPTION VALUES
+// =============================================================================
+
+// --record PATH, raw source trace written while the monitor runs
+static string record_path;
+
+// --root DIR / --replay PATH, read /proc and /sys from a fixture tree or a trace
+static string source_root;
+static string replay_path;
+
+bool headless_mode = false;     ///< --headless, run the sampler without a window
+string headless_output;         ///< --output PATH for headless snapshots; empty writes to stdout
+int headless_interval_ms = 1000; ///< --interval MS between headless snapshots
+
+// =============================================================================
+// PARSING
+// =============================================================================
+
+/**
+ * @brief Describes the supported command line options
+ */
+void printUsage(const char *program)
+{
+    printf("Usage: %s [options]\n", program);
+    printf("  --scan-workers N   threads used to scan /proc (default: %d)\n", process_scan_workers);
+    printf("  --no-proc-events   poll /proc instead of using the netlink proc connector\n");
+    printf("  --taskstats        query taskstats for nanosecond CPU time and run/IO delays\n");
+    printf("  --store PATH       keep metric history in a memory-mapped file across restarts\n");
+    printf("  --store-size MB    size cap of the store file (default: %zu)\n", metric_store_size_mb);
+    printf("  --record PATH      capture every raw /proc and /sys read to a trace file\n");
+    printf("  --root DIR         read /proc and /sys from a fixture tree under DIR\n");
+    printf("  --replay PATH      play back a trace written with --record\n");
+    printf("  --metrics-port N   serve Prometheus metrics on http://127.0.0.1:N/metrics\n");
+    printf("  --headless         run the collectors without a window, printing snapshots\n");
+    printf("  --output PATH      append headless snapshots to PATH instead of stdout\n");
+    printf("  --interval MS      milliseconds between headless snapshots (default: %d)\n", headless_interval_ms);
+    printf("  --help             show this message\n");
+}
+
+/**
+ * @brief Applies command line options
+ * @param exit_code Receives the exit status when the program should stop
+ * @return false if the program should exit (--help or an unknown option)
+ */
+bool parseArguments(int argc, char **argv, int &exit_code)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if (arg == "--scan-workers" && i + 1 < argc)
+        {
+            process_scan_workers = max(1, atoi(argv[++i]));
+        }
+        else if (arg == "--no-proc-events")
+        {
+            process_events_enabled = false;
+        }
+        else if (arg == "--taskstats")
+        {
+            taskstats_enabled = true;
+        }
+        else if (arg == "--store" && i + 1 < argc)
+        {
+            metric_store_path = argv[++i];
+        }
+        else if (arg == "--store-size" && i + 1 < argc)
+        {
+            metric_store_size_mb = max(1, atoi(argv[++i]));
+        }
+        else if (arg == "--record" && i + 1 < argc)
+        {
+            record_path = argv[++i];
+        }
+        else if (arg == "--root" && i + 1 < argc)
+        {
+            source_root = argv[++i];
+        }
+        else if (arg == "--replay" && i + 1 < argc)
+        {
+            replay_path = argv[++i];
+        }
+        else if (arg == "--metrics-port" && i + 1 < argc)
+        {
+            metrics_port = max(0, min(65535, atoi(argv[++i])));
+        }
+        else if (arg == "--headless")
+        {
+            headless_mode = true;
+        }
+        else if (arg == "--output" && i + 1 < argc)
+        {
+            headless_output = argv[++i];
+        }
+        else if (arg == "--interval" && i + 1 < argc)
+        {
+            headless_interval_ms = max(10, atoi(argv[++i]));
+        }
+        else if (arg == "--help" || arg == "-h")
+        {
+            printUsage(argv[0]);
+            exit_code = 0;
+            return false;
+        }
+        else
+        {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            printUsage(argv[0]);
+            exit_code = 1;
+            return false;
+        }
+    }
+    return true;
+}
+
+// =============================================================================
+// COLLECTION START-UP
+// =============================================================================
+
+/**
+ * @brief Installs the --root or --replay backend
+ * @return false if the replay trace cannot be loaded
+ */
+bool selectDataSource()
+{
+    if (!replay_path.empty())
+    {
+        auto replay = make_unique<ReplaySource>();
+        string error;
+        if (!replay->open(replay_path, error))
+        {
+            fprintf(stderr, "Cannot replay %s: %s\n", replay_path.c_str(), error.c_str());
+            return false;
+        }
+        setDataSource(move(replay));
+    }
+    else if (!source_root.empty())
+    {
+        setDataSource(make_unique<FileTreeSource>(source_root));
+    }
+    else
+    {
+        return true;
+    }
+
+    // Process events and taskstats describe the live kernel, not the source
+    process_events_enabled = false;
+    taskstats_enabled = false;
+    return true;
+}
+
+/**
+ * @brief Opens the metric store, trace recorder and metrics endpoint if requested,
+ *        then starts the sampler
+ * @note Failing to open any of them only prints a warning; collection still runs.
+ */
+void startCollection()
+{
+    if (!metric_store_path.empty() && !openMetricStore(metric_store_path, metric_store_size_mb))
+    {
+        fprintf(stderr, "Warning: cannot open metric store %s: %s\n", metric_store_path.c_str(),
+                errno == EBUSY ? "in use by another monitor" : strerror(errno));
+    }
+    if (!record_path.empty() && !openTraceRecorder(record_path))
+    {
+        fprintf(stderr, "Warning: cannot create trace file %s: %s\n", record_path.c_str(), strerror(errno));
+    }
+    if (metrics_port > 0 && !startMetricsServer(metrics_port))
+    {
+        fprintf(stderr, "Warning: cannot serve metrics on port %d: %s\n", metrics_port, strerror(errno));
+    }
+    startSampler();
+}
+
+/**
+ * @brief Stops the sampler, then the metrics endpoint, then flushes and closes the trace
+ */
+void stopCollection()
+{
+    stopSampler();
+    stopMetricsServer();
+    closeTraceRecorder();
+}
@@ -0,0 +1,103 @@
+/**
+ * @file overhead.cpp
+ * @brief Counters for the monitor's own cost: collector I/O and heap allocations
+ * @details The collectors report every syscall they issue against /proc and
+ *          /sys (open, read, pread, getdents64, close, statvfs, ...) and the
+ *          bytes they read through countCollectorIo(). The sampler brackets
+ *          each collector run with these totals, so the difference is that
+ *          collector's cost, including the work of the scan worker threads.
+ *
+ *          Heap allocations are counted by replacing the global operator
+ *          new/delete. Every thread keeps a plain thread-local count (used for
+ *          per-frame allocations on the render thread); threads tagged with
+ *          countAllocationsForCollectors() (the sampler and the scan workers)
+ *          also add to a shared counter, which the sampler brackets like the
+ *          I/O counters.
+ *
+ *          Library calls that issue several syscalls internally (opendir()/
+ *          readdir(), getifaddrs()) are counted as the syscalls they make on
+ *          a typical call; everything issued directly is counted exactly.
+ * @author Stephen Kisengese
+ * @date 2025
+ */
+
+#include "collector.h"
+#include <new>
+
+// =============================================================================
+// COLLECTOR I/O
+// =============================================================================
+
+atomic<uint64_t> collector_syscalls(0);   ///< Syscalls issued by collectors since start
+atomic<uint64_t> collector_bytes_read(0); ///< Bytes read from /proc and /sys since start
+
+// =============================================================================
+// HEAP ALLOCATIONS
+// =============================================================================
+
+static atomic<uint64_t> collector_allocations(0);  ///< Allocations on tagged threads
+static thread_local bool allocations_for_collectors = false;
+static thread_local uint64_t thread_allocations = 0;
+
+/**
+ * @brief Counts the calling thread's allocations towards the collectors
+ * @note Called once by the sampler thread and by every scan worker.
+ */
+void countAllocationsForCollectors()
+{
+    allocations_for_collectors = true;
+}
+
+uint64_t collectorAllocations()
+{
+    return collector_allocations.load(memory_order_relaxed);
+}
+
+/**
+ * @brief Heap allocations made by the calling thread since it started
+ */
+uint64_t threadAllocations()
+{
+    return thread_allocations;
+}
+
+static inline void *countedAllocation(size_t size)
+{
+    thread_allocations++;
+    if (allocations_for_collectors)
+        collector_allocations.fetch_add(1, memory_order_relaxed);
+    return malloc(size == 0 ? 1 : size);
+}
+
+void *operator new(size_t size)
+{
+    void *p = countedAllocation(size);
+    if (p == nullptr)
+        throw bad_alloc();
+    return p;
+}
+
+void *operator new[](size_t size)
+{
+    void *p = countedAllocation(size);
+    if (p == nullptr)
+        throw bad_alloc();
+    return p;
+}
+
+void *operator new(size_t size, const nothrow_t &) noexcept
+{
+    return countedAllocation(size);
+}
+
+void *operator new[](size_t size, const nothrow_t &) noexcept
+{
+    return countedAllocation(size);
+}
+
+void operator delete(void *p) noexcept { free(p); }
+void operator delete[](void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+void operator delete[](void *p, size_t) noexcept { free(p); }
+void operator delete(void *p, const nothrow_t &) noexcept { free(p); }
+void operator delete[](void *p, const nothrow_t &) noexcept { free(p); }
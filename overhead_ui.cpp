@@ -0,0 +1,313 @@
+/**
+ * @file overhead_ui.cpp
+ * @brief Frame-stage timing and the "Monitor Overhead" tab
+ * @details The main loop marks the start of every frame stage (collect,
+ *          NewFrame, view build, render, swap) with beginFrameStage() and
+ *          closes the frame with endFrame(). Each stage, and the frame as a
+ *          whole, keeps last/avg/max times and a log2 histogram, so rare
+ *          slow frames stay visible next to the average. Stages and frames
+ *          are also recorded as trace zones (zones.cpp), so a dumped trace
+ *          shows which stage of which frame ran long.
+ *
+ *          The tab puts these next to the per-collector costs accumulated by
+ *          the sampler (see overhead.cpp and sampler.cpp) and the process's
+ *          own CPU time, to show how much of the machine the monitor uses.
+ * @author Stephen Kisengese
+ * @date 2025
+ */
+
+#include "header.h"
+#include <sys/resource.h>
+
+// =============================================================================
+// FRAME STAGE TIMING
+// =============================================================================
+
+// Bucket 0 holds frames under 16 us; bucket i holds [16 * 2^(i-1), 16 * 2^i) us
+#define FRAME_HISTOGRAM_BUCKETS 16
+static const double first_bucket_us = 16.0;
+
+/**
+ * @brief Timing of one frame stage (or of whole frames) since the last reset
+ */
+struct StageTiming
+{
+    double last_ms;
+    double total_ms;
+    double max_ms;
+    uint64_t count;
+    float histogram[FRAME_HISTOGRAM_BUCKETS]; ///< float so PlotHistogram can read it in place
+};
+
+static const char *const stage_names[FRAME_STAGE_COUNT + 1] = {
+    "Collect (events)", "NewFrame", "View build", "Render", "Swap", "Whole frame"};
+
+static StageTiming stage_timing[FRAME_STAGE_COUNT + 1]; ///< Per stage, then the whole frame
+static int current_stage = -1;                          ///< Stage being timed, -1 between frames
+static uint64_t stage_start_ns = 0;                     ///< zoneClockNs() when the current stage began
+static uint64_t frame_start_ns = 0;
+static uint64_t frame_start_allocations = 0;
+static uint64_t last_frame_allocations = 0;
+static uint64_t total_frame_allocations = 0;
+
+static int histogramBucket(double ms)
+{
+    double us = ms * 1000.0;
+    if (us < first_bucket_us)
+        return 0;
+    int bucket = 1 + (int)log2(us / first_bucket_us);
+    return min(bucket, FRAME_HISTOGRAM_BUCKETS - 1);
+}
+
+static void addTiming(StageTiming &timing, double ms)
+{
+    timing.last_ms = ms;
+    timing.total_ms += ms;
+    timing.max_ms = max(timing.max_ms, ms);
+    timing.count++;
+    timing.histogram[histogramBucket(ms)] += 1.0f;
+}
+
+/**
+ * @brief Ends the current stage (if any) and starts timing @p stage
+ * @note Render thread only. The first stage of a frame also starts the frame.
+ */
+void beginFrameStage(FrameStage stage)
+{
+    uint64_t now_ns = zoneClockNs();
+    if (current_stage >= 0)
+    {
+        addTiming(stage_timing[current_stage], (now_ns - stage_start_ns) / 1e6);
+        recordZone(stage_names[current_stage], stage_start_ns, now_ns);
+    }
+    else
+    {
+        frame_start_ns = now_ns;
+        frame_start_allocations = threadAllocations();
+    }
+    current_stage = stage;
+    stage_start_ns = now_ns;
+}
+
+/**
+ * @brief Ends the current stage and records the whole frame
+ */
+void endFrame()
+{
+    if (current_stage < 0)
+        return;
+
+    uint64_t now_ns = zoneClockNs();
+    addTiming(stage_timing[current_stage], (now_ns - stage_start_ns) / 1e6);
+    addTiming(stage_timing[FRAME_STAGE_COUNT], (now_ns - frame_start_ns) / 1e6);
+    recordZone(stage_names[current_stage], stage_start_ns, now_ns);
+    recordZone("Frame", frame_start_ns, now_ns);
+    current_stage = -1;
+
+    last_frame_allocations = threadAllocations() - frame_start_allocations;
+    total_frame_allocations += last_frame_allocations;
+}
+
+/**
+ * @brief Upper edge of the histogram bucket holding the @p fraction quantile, in ms
+ */
+static double quantileMs(const StageTiming &timing, double fraction)
+{
+    double target = fraction * timing.count;
+    double seen = 0;
+    for (int i = 0; i < FRAME_HISTOGRAM_BUCKETS; i++)
+    {
+        seen += timing.histogram[i];
+        if (seen >= target)
+            return first_bucket_us * pow(2.0, i) / 1000.0;
+    }
+    return timing.max_ms;
+}
+
+// =============================================================================
+// MONITOR OVERHEAD TAB
+// =============================================================================
+
+/**
+ * @brief CPU used by the whole monitor process, as a share of one CPU
+ * @details Refreshed at most once a second from getrusage(), which needs no
+ *          /proc access.
+ */
+static float processCPUPercent()
+{
+    static float percent = 0.0f;
+    static double last_cpu_s = -1.0;
+    static chrono::steady_clock::time_point last_time;
+
+    auto now = chrono::steady_clock::now();
+    if (last_cpu_s >= 0.0 && now - last_time < chrono::seconds(1))
+        return percent;
+
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    double cpu_s = usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+                   (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+    if (last_cpu_s >= 0.0)
+    {
+        double wall_s = chrono::duration<double>(now - last_time).count();
+        percent = (float)((cpu_s - last_cpu_s) / wall_s * 100.0);
+    }
+    last_cpu_s = cpu_s;
+    last_time = now;
+    return percent;
+}
+
+static void renderCollectorCosts()
+{
+    const vector<CollectorCost> &costs = getCollectorCosts();
+    if (costs.empty())
+    {
+        ImGui::Text("Waiting for the first sampler cycle...");
+        return;
+    }
+
+    ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg;
+    if (ImGui::BeginTable("collector_costs", 8, flags))
+    {
+        ImGui::TableSetupColumn("Collector");
+        ImGui::TableSetupColumn("Runs");
+        ImGui::TableSetupColumn("Last ms");
+        ImGui::TableSetupColumn("Avg ms");
+        ImGui::TableSetupColumn("Max ms");
+        ImGui::TableSetupColumn("Syscalls/run");
+        ImGui::TableSetupColumn("Read/run");
+        ImGui::TableSetupColumn("Allocs/run");
+        ImGui::TableHeadersRow();
+
+        for (const CollectorCost &cost : costs)
+        {
+            if (cost.runs == 0)
+                continue;
+            double runs = (double)cost.runs;
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(cost.name);
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", (unsigned long long)cost.runs);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", cost.last_ms);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", cost.total_ms / runs);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", cost.max_ms);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.0f", cost.syscalls / runs);
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(formatBytes((unsigned long)(cost.bytes_read / runs)).c_str());
+            ImGui::TableNextColumn();
+            ImGui::Text("%.0f", cost.allocations / runs);
+        }
+        ImGui::EndTable();
+    }
+}
+
+static void renderFrameTimes()
+{
+    static int selected_stage = FRAME_STAGE_COUNT;
+
+    if (ImGui::Button("Reset##frames"))
+    {
+        memset(stage_timing, 0, sizeof(stage_timing));
+        total_frame_allocations = 0;
+    }
+    const StageTiming &frame = stage_timing[FRAME_STAGE_COUNT];
+    ImGui::SameLine();
+    ImGui::Text("Frames: %llu   Allocations/frame: %llu last, %.1f avg", (unsigned long long)frame.count,
+                (unsigned long long)last_frame_allocations,
+                frame.count > 0 ? (double)total_frame_allocations / frame.count : 0.0);
+
+    ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg;
+    if (ImGui::BeginTable("frame_stages", 6, flags))
+    {
+        ImGui::TableSetupColumn("Stage");
+        ImGui::TableSetupColumn("Last ms");
+        ImGui::TableSetupColumn("Avg ms");
+        ImGui::TableSetupColumn("Max ms");
+        ImGui::TableSetupColumn("p50 <=");
+        ImGui::TableSetupColumn("p99 <=");
+        ImGui::TableHeadersRow();
+
+        for (int i = 0; i <= FRAME_STAGE_COUNT; i++)
+        {
+            const StageTiming &timing = stage_timing[i];
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            if (ImGui::Selectable(stage_names[i], selected_stage == i, ImGuiSelectableFlags_SpanAllColumns))
+                selected_stage = i;
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", timing.last_ms);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", timing.count > 0 ? timing.total_ms / timing.count : 0.0);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", timing.max_ms);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", quantileMs(timing, 0.50));
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", quantileMs(timing, 0.99));
+        }
+        ImGui::EndTable();
+    }
+
+    // Histogram of the stage selected in the table
+    char overlay[64];
+    snprintf(overlay, sizeof(overlay), "%s: 16 us .. %.0f ms, log2 buckets", stage_names[selected_stage],
+             first_bucket_us * pow(2.0, FRAME_HISTOGRAM_BUCKETS - 1) / 1000.0);
+    ImGui::PlotHistogram("##frame_histogram", stage_timing[selected_stage].histogram, FRAME_HISTOGRAM_BUCKETS,
+                         0, overlay, 0.0f, FLT_MAX, ImVec2(ImGui::GetContentRegionAvail().x, 100));
+    ImGui::TextDisabled("Swap includes the vsync wait, so it absorbs the idle part of each frame.");
+}
+
+static void renderZoneDump()
+{
+    static string dump_status;
+
+    if (ImGui::Button("Dump trace"))
+    {
+        string path;
+        if (dumpZoneTraceNow(path))
+            dump_status = "Wrote " + path;
+        else
+            dump_status = "Cannot write " + path + ": " + strerror(errno);
+    }
+    ImGui::SameLine();
+    ImGui::TextUnformatted(dump_status.empty() ? "Recent zones of every thread, as Chrome trace JSON"
+                                               : dump_status.c_str());
+    ImGui::TextDisabled("Open the file in chrome://tracing or ui.perfetto.dev.");
+    if (droppedZoneThreads() > 0)
+        ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.0f, 1.0f), "%d threads started after the zone table filled are not recorded.",
+                           droppedZoneThreads());
+}
+
+/**
+ * @brief Renders the "Monitor Overhead" tab of the System window
+ * @details Shows the monitor's own CPU use, every collector's cost per run
+ *          (wall time, syscalls, bytes read, allocations), the frame stage
+ *          timings with a histogram of the selected stage, and a button that
+ *          dumps the trace zones.
+ */
+void renderOverheadPanel()
+{
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    ImGui::Text("Monitor process: %.1f%% of one CPU, peak RSS %s", processCPUPercent(),
+                formatBytes((unsigned long)usage.ru_maxrss * 1024).c_str());
+    ImGui::Spacing();
+
+    if (ImGui::CollapsingHeader("Collectors (sampler thread)", ImGuiTreeNodeFlags_DefaultOpen))
+    {
+        renderCollectorCosts();
+    }
+    if (ImGui::CollapsingHeader("Frame stages (render thread)", ImGuiTreeNodeFlags_DefaultOpen))
+    {
+        renderFrameTimes();
+    }
+    if (ImGui::CollapsingHeader("Trace zones", ImGuiTreeNodeFlags_DefaultOpen))
+    {
+        renderZoneDump();
+    }
+}
@@ -0,0 +1,792 @@
+/**
+ * @file process.cpp
+ * @brief Low-level access to per-process /proc files
+ * @details The process scan reads /proc/[pid]/stat for every process on every
+ *          tick, which makes this the hottest path in the monitor. Everything
+ *          here works on fixed-size stack buffers and raw file descriptors:
+ *          no iostreams, no std::string temporaries and no tokenizing.
+ *          Descriptors are kept open across ticks in ProcFdCache so a
+ *          long-lived process costs one pread() per tick.
+ * @author Stephen Kisengese
+ * @date 2025
+ */
+
+#include "collector.h"
+#include <charconv>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+
+// =============================================================================
+// /proc/[pid]/stat PARSING
+// =============================================================================
+
+/**
+ * @brief Parses one numeric stat field starting at @p p
+ * @return Pointer just past the number, or nullptr if no digits were found
+ */
+template <typename T>
+static const char *parseField(const char *p, const char *end, T &value)
+{
+    auto result = from_chars(p, end, value);
+    if (result.ec != errc())
+        return nullptr;
+    return result.ptr;
+}
+
+/**
+ * @brief Advances @p p past @p count space-separated fields
+ * @return Pointer to the first character of the next field, or nullptr at end of buffer
+ */
+static const char *skipFields(const char *p, const char *end, int count)
+{
+    while (count > 0 && p < end)
+    {
+        const char *space = static_cast<const char *>(memchr(p, ' ', end - p));
+        if (space == nullptr)
+            return nullptr;
+        p = space + 1;
+        count--;
+    }
+    return count == 0 ? p : nullptr;
+}
+
+/**
+ * @brief Parses the contents of a /proc/[pid]/stat file without allocating
+ * @param buf Raw file contents (need not be NUL-terminated)
+ * @param len Number of valid bytes in @p buf
+ * @param out Receives the parsed fields
+ * @return true if every required field was found
+ *
+ * The line has the form "pid (comm) state ppid ...". The command name may
+ * itself contain spaces and parentheses, so it is delimited by the first
+ * '(' and the *last* ')' in the buffer. Only the fields the monitor uses are
+ * converted, each with std::from_chars.
+ *
+ * Fields extracted (1-based, as in proc(5)):
+ * - 1 pid, 2 comm, 3 state, 4 ppid
+ * - 14 utime, 15 stime (clock ticks)
+ * - 20 num_threads, 22 starttime (clock ticks since boot)
+ * - 23 vsize (bytes), 24 rss (pages)
+ */
+bool parseProcStat(const char *buf, size_t len, ProcStat &out)
+{
+    const char *end = buf + len;
+
+    const char *open_paren = static_cast<const char *>(memchr(buf, '(', len));
+    const char *close_paren = static_cast<const char *>(memrchr(buf, ')', len));
+    if (open_paren == nullptr || close_paren == nullptr || close_paren < open_paren)
+        return false;
+
+    // Field 1: pid (everything before the opening parenthesis)
+    if (parseField(buf, open_paren, out.pid) == nullptr)
+        return false;
+
+    // Field 2: comm, truncated to the fixed buffer if necessary
+    size_t comm_len = min<size_t>(close_paren - open_paren - 1, sizeof(out.comm) - 1);
+    memcpy(out.comm, open_paren + 1, comm_len);
+    out.comm[comm_len] = '\0';
+    out.comm_len = comm_len;
+
+    // Field 3: state, right after ") "
+    const char *p = close_paren + 2;
+    if (p >= end)
+        return false;
+    out.state = *p;
+
+    // Field 4: ppid
+    if ((p = skipFields(p, end, 1)) == nullptr || (p = parseField(p, end, out.ppid)) == nullptr)
+        return false;
+
+    // Fields 14-15: utime, stime
+    if ((p = skipFields(p + 1, end, 9)) == nullptr || (p = parseField(p, end, out.utime)) == nullptr)
+        return false;
+    if ((p = parseField(p + 1, end, out.stime)) == nullptr)
+        return false;
+
+    // Field 20: num_threads
+    if ((p = skipFields(p + 1, end, 4)) == nullptr || (p = parseField(p, end, out.num_threads)) == nullptr)
+        return false;
+
+    // Fields 22-24: starttime, vsize, rss
+    if ((p = skipFields(p + 1, end, 1)) == nullptr || (p = parseField(p, end, out.starttime)) == nullptr)
+        return false;
+    if ((p = parseField(p + 1, end, out.vsize)) == nullptr)
+        return false;
+    if (parseField(p + 1, end, out.rss) == nullptr)
+        return false;
+
+    return true;
+}
+
+// =============================================================================
+// PER-PID FILE DESCRIPTOR CACHE
+// =============================================================================
+
+/**
+ * @brief File names under /proc/[pid]/ indexed by ProcFile
+ */
+static const char *const proc_file_names[PROC_FILE_COUNT] = {"stat", "statm", "io"};
+
+/**
+ * @brief Writes "<pid>/<file>" (relative to the /proc dirfd) into @p path
+ */
+static void formatProcPath(char (&path)[32], int pid, ProcFile file)
+{
+    char *p = to_chars(path, path + 16, pid).ptr;
+    *p++ = '/';
+    strcpy(p, proc_file_names[file]);
+}
+
+/**
+ * @brief Writes the live absolute path "/proc/<pid>/<file>" into @p path
+ */
+static void formatAbsoluteProcPath(char (&path)[40], int pid, ProcFile file)
+{
+    char relative[32];
+    formatProcPath(relative, pid, file);
+    memcpy(path, "/proc/", 6);
+    strcpy(path + 6, relative);
+}
+
+/**
+ * @brief Passes a /proc/[pid]/<file> read (or its failure, len <= 0) to the trace recorder
+ */
+static void traceProcRead(int pid, ProcFile file, const char *buf, ssize_t len)
+{
+    char path[40];
+    formatAbsoluteProcPath(path, pid, file);
+
+    if (len > 0)
+        recordSourceRead(path, buf, len);
+    else
+        recordSourceMissing(path);
+}
+
+/**
+ * @brief Reads /proc/[pid]/<file> through the active DataSource
+ * @details Used when the source is not a real directory tree (trace replay),
+ *          so there are no descriptors to cache.
+ */
+static ssize_t readProcFromSource(int pid, ProcFile file, char *buf, size_t size)
+{
+    char path[40];
+    formatAbsoluteProcPath(path, pid, file);
+
+    static thread_local string contents;
+    if (!readSourceFile(path, contents) || contents.empty())
+        return -1;
+
+    size_t len = min(contents.size(), size);
+    memcpy(buf, contents.data(), len);
+    return len;
+}
+
+/**
+ * @brief Computes the default cache capacity from RLIMIT_NOFILE
+ * @details The soft limit is first raised towards the hard limit (capped at
+ *          65536) since a cache of open descriptors is exactly what the limit
+ *          is meant to bound. Half of the resulting limit is left for the rest
+ *          of the application (SDL, OpenGL, sockets, the /proc dirfd, ...).
+ */
+size_t ProcFdCache::defaultCapacity()
+{
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) != 0)
+        return 256;
+
+    rlim_t wanted = limit.rlim_max == RLIM_INFINITY ? 65536 : min<rlim_t>(limit.rlim_max, 65536);
+    if (limit.rlim_cur != RLIM_INFINITY && limit.rlim_cur < wanted)
+    {
+        struct rlimit raised = limit;
+        raised.rlim_cur = wanted;
+        if (setrlimit(RLIMIT_NOFILE, &raised) == 0)
+            limit = raised;
+    }
+
+    rlim_t usable = limit.rlim_cur == RLIM_INFINITY ? 65536 : limit.rlim_cur;
+    return max<size_t>(usable / 2, 16);
+}
+
+ProcFdCache::ProcFdCache(size_t max_open_fds)
+    : capacity(max_open_fds == 0 ? defaultCapacity() : max<size_t>(max_open_fds, PROC_FILE_COUNT))
+{
+    // Fixtures are opened under their root; replayed traces have no tree
+    // (proc_dirfd stays -1) and are read through the DataSource instead
+    const char *root = dataSource().fileRoot();
+    if (root != nullptr)
+        proc_dirfd = open((string(root) + "/proc").c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+}
+
+ProcFdCache::~ProcFdCache()
+{
+    for (auto &pair : entries)
+    {
+        closeEntry(pair.second);
+    }
+    if (proc_dirfd >= 0)
+    {
+        close(proc_dirfd);
+    }
+}
+
+/**
+ * @brief Closes every descriptor held by an entry and updates the fd count
+ */
+void ProcFdCache::closeEntry(Entry &entry)
+{
+    for (int &fd : entry.fds)
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+            countCollectorIo(1);
+            fd = -1;
+            open_fds--;
+        }
+    }
+}
+
+/**
+ * @brief Removes a PID from the cache, closing its descriptors
+ */
+void ProcFdCache::evict(int pid)
+{
+    auto it = entries.find(pid);
+    if (it == entries.end())
+        return;
+
+    closeEntry(it->second);
+    lru.erase(it->second.lru_position);
+    entries.erase(it);
+}
+
+/**
+ * @brief Closes least recently used entries until one more fd fits
+ */
+void ProcFdCache::makeRoom()
+{
+    while (open_fds >= capacity && !lru.empty())
+    {
+        evict(lru.back());
+    }
+}
+
+/**
+ * @brief Reads /proc/[pid]/<file> from offset 0, reusing a cached descriptor
+ * @param pid Process ID to read
+ * @param file Which per-process file to read
+ * @param buf Destination buffer
+ * @param size Size of @p buf in bytes
+ * @return Number of bytes read, or -1 if the process is gone
+ *
+ * On a cache hit this is a single pread() syscall instead of the
+ * open/read/close triple. On a miss the file is opened with openat()
+ * relative to the held /proc dirfd, so the kernel does not resolve
+ * "/proc" again for every process. A failed read (ESRCH once the process has been
+ * reaped) evicts the PID. If the descriptor came from the cache, the read is
+ * retried once with a fresh openat(), since the PID may already belong to a
+ * new process that the listing just returned.
+ */
+ssize_t ProcFdCache::read(int pid, ProcFile file, char *buf, size_t size)
+{
+    if (proc_dirfd < 0)
+        return readProcFromSource(pid, file, buf, size);
+
+    auto it = entries.find(pid);
+    if (it == entries.end())
+    {
+        lru.push_front(pid);
+        Entry entry;
+        entry.lru_position = lru.begin();
+        it = entries.emplace(pid, entry).first;
+    }
+    else
+    {
+        lru.splice(lru.begin(), lru, it->second.lru_position);
+    }
+
+    Entry &entry = it->second;
+    entry.last_scan = scan_generation;
+
+    bool cached = entry.fds[file] >= 0;
+    if (!cached)
+    {
+        makeRoom();
+        // With capacity >= PROC_FILE_COUNT, makeRoom() never reaches the entry at the front
+        char path[32];
+        formatProcPath(path, pid, file);
+        entry.fds[file] = openat(proc_dirfd, path, O_RDONLY | O_CLOEXEC);
+        countCollectorIo(1);
+        if (entry.fds[file] < 0)
+        {
+            if (traceRecorderActive())
+                traceProcRead(pid, file, nullptr, -1);
+            evict(pid);
+            return -1;
+        }
+        open_fds++;
+    }
+
+    ssize_t len = pread(entry.fds[file], buf, size, 0);
+    countCollectorIo(1, max<ssize_t>(len, 0));
+    if (traceRecorderActive())
+        traceProcRead(pid, file, buf, len);
+    if (len <= 0)
+    {
+        evict(pid); // ESRCH: the process has exited and been reaped
+        // The cached descriptor may point at an earlier process with this PID
+        return cached ? read(pid, file, buf, size) : -1;
+    }
+    return len;
+}
+
+/**
+ * @brief Marks the start of a full /proc scan
+ */
+void ProcFdCache::beginScan()
+{
+    scan_generation++;
+}
+
+/**
+ * @brief Evicts every PID that was not read since the last beginScan()
+ * @details Called after a full scan so processes that vanished from /proc
+ *          release their descriptors even if no read ever failed on them.
+ */
+void ProcFdCache::evictStale()
+{
+    for (auto it = entries.begin(); it != entries.end();)
+    {
+        if (it->second.last_scan != scan_generation)
+        {
+            closeEntry(it->second);
+            lru.erase(it->second.lru_position);
+            it = entries.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+// =============================================================================
+// /proc ENUMERATION
+// =============================================================================
+
+/**
+ * @brief Directory record returned by getdents64(2)
+ */
+struct LinuxDirent64
+{
+    uint64_t d_ino;
+    int64_t d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[];
+};
+
+/**
+ * @brief Size of the buffer handed to each getdents64() call
+ * @details 64 KiB holds roughly 2,700 PID entries, so a 50k-process /proc is
+ *          enumerated in about 20 syscalls.
+ */
+static const size_t GETDENTS_BUFFER_SIZE = 64 * 1024;
+
+/**
+ * @brief Lists every PID in /proc using large getdents64() batches
+ * @param proc_dirfd Open descriptor of the /proc directory
+ * @param pids Receives the PIDs (cleared first), in directory order
+ * @return false if the directory could not be read
+ *
+ * PIDs are parsed in place from the d_name bytes with std::from_chars;
+ * non-numeric entries ("self", "sys", ...) are rejected on their first
+ * character. The descriptor is rewound first so it can be reused every tick.
+ */
+bool listProcPids(int proc_dirfd, vector<int> &pids)
+{
+    pids.clear();
+    if (proc_dirfd < 0 || lseek(proc_dirfd, 0, SEEK_SET) < 0)
+        return false;
+
+    alignas(LinuxDirent64) static thread_local char buf[GETDENTS_BUFFER_SIZE];
+
+    countCollectorIo(1); // lseek
+    while (true)
+    {
+        long nread = syscall(SYS_getdents64, proc_dirfd, buf, sizeof(buf));
+        countCollectorIo(1, max(nread, 0L));
+        if (nread < 0)
+            return false;
+        if (nread == 0)
+            break;
+
+        for (long offset = 0; offset < nread;)
+        {
+            const LinuxDirent64 *entry = reinterpret_cast<const LinuxDirent64 *>(buf + offset);
+            offset += entry->d_reclen;
+
+            const char *name = entry->d_name;
+            if (name[0] < '1' || name[0] > '9')
+                continue;
+
+            int pid;
+            auto result = from_chars(name, name + strlen(name), pid);
+            if (result.ec == errc() && *result.ptr == '\0')
+                pids.push_back(pid);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Lists the PIDs in /proc through the active DataSource
+ * @details Fallback for sources without a real /proc directory (trace
+ *          replay); the live system and fixtures use listProcPids().
+ */
+static bool listSourcePids(vector<int> &pids)
+{
+    pids.clear();
+    vector<string> names;
+    if (!dataSource().listDirectory("/proc", names))
+        return false;
+
+    for (const string &name : names)
+    {
+        int pid;
+        auto result = from_chars(name.data(), name.data() + name.size(), pid);
+        if (result.ec == errc() && result.ptr == name.data() + name.size() && pid > 0)
+            pids.push_back(pid);
+    }
+    return true;
+}
+
+// =============================================================================
+// PROCESS INFORMATION
+// =============================================================================
+
+/**
+ * @brief Reads and parses /proc/[pid]/stat with a single raw read()
+ * @param pid Process ID to query
+ * @param out Receives the parsed fields
+ * @return false if the process vanished or the file could not be parsed
+ */
+bool readProcStat(int pid, ProcStat &out)
+{
+    const char *root = dataSource().fileRoot();
+    if (root == nullptr || *root != '\0')
+    {
+        char buf[PROC_STAT_BUFFER_SIZE];
+        ssize_t len = readProcFromSource(pid, PROC_FILE_STAT, buf, sizeof(buf));
+        return len > 0 && parseProcStat(buf, len, out);
+    }
+
+    // Build "/proc/<pid>/stat" in place
+    char path[32] = "/proc/";
+    char *p = to_chars(path + 6, path + sizeof(path) - 6, pid).ptr;
+    memcpy(p, "/stat", 6);
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        countCollectorIo(1);
+        recordSourceMissing(path);
+        return false;
+    }
+
+    char buf[PROC_STAT_BUFFER_SIZE];
+    ssize_t len = read(fd, buf, sizeof(buf));
+    close(fd);
+    countCollectorIo(3, max<ssize_t>(len, 0));
+
+    if (traceRecorderActive())
+        traceProcRead(pid, PROC_FILE_STAT, buf, len);
+
+    return len > 0 && parseProcStat(buf, len, out);
+}
+
+/**
+ * @brief Reads and parses /proc/[pid]/stat through a descriptor cache
+ * @param cache Cache holding the per-PID descriptors
+ * @param pid Process ID to query
+ * @param out Receives the parsed fields
+ * @return false if the process vanished or the file could not be parsed
+ */
+bool readProcStat(ProcFdCache &cache, int pid, ProcStat &out)
+{
+    char buf[PROC_STAT_BUFFER_SIZE];
+    ssize_t len = cache.read(pid, PROC_FILE_STAT, buf, sizeof(buf));
+
+    return len > 0 && parseProcStat(buf, len, out);
+}
+
+/**
+ * @brief Copies the fields the process table uses from a parsed stat line
+ */
+static void fillProc(Proc &proc, const ProcStat &stat)
+{
+    proc.name.assign(stat.comm, stat.comm_len);
+    proc.state = stat.state;
+    proc.utime = stat.utime;
+    proc.stime = stat.stime;
+    proc.starttime = stat.starttime;
+    proc.vsize = stat.vsize;
+    proc.rss = stat.rss;
+}
+
+/**
+ * @brief Retrieves detailed information about a specific process
+ * @param pid Process ID to query
+ * @return Proc structure containing process information
+ * @details Reads /proc/[pid]/stat once. The command name in the stat line is
+ *          the same string /proc/[pid]/comm reports, so comm is not opened.
+ *          Returns a Proc with an empty name if the process disappeared.
+ *
+ * Process state codes:
+ * - R: Running
+ * - S: Sleeping (interruptible)
+ * - D: Disk sleep (uninterruptible)
+ * - I: Idle
+ * - Z: Zombie
+ * - T: Stopped
+ */
+Proc getProcessInfo(int pid)
+{
+    Proc proc = {};
+    proc.pid = pid;
+
+    ProcStat stat;
+    if (readProcStat(pid, stat))
+    {
+        fillProc(proc, stat);
+    }
+
+    return proc;
+}
+
+/**
+ * @brief Retrieves process information, re-reading a cached descriptor
+ * @param cache Descriptor cache owned by the scanning thread
+ * @param pid Process ID to query
+ * @return Proc structure; the name is empty if the process disappeared
+ */
+Proc getProcessInfo(ProcFdCache &cache, int pid)
+{
+    Proc proc = {};
+    proc.pid = pid;
+
+    ProcStat stat;
+    if (readProcStat(cache, pid, stat))
+    {
+        fillProc(proc, stat);
+    }
+
+    return proc;
+}
+
+// =============================================================================
+// PARALLEL PROCESS SCAN
+// =============================================================================
+
+/**
+ * @brief Number of workers used by getAllProcesses(); set before the first scan
+ * @details Defaults to one worker per 8 hardware threads (1-16), so small
+ *          desktops keep the single-threaded path and large hosts split the
+ *          scan. Overridden with --scan-workers.
+ */
+int process_scan_workers = max(1, min(16, (int)thread::hardware_concurrency() / 8));
+
+/**
+ * @brief Creates a scanner with @p workers workers (clamped to at least 1)
+ * @details Worker 0 runs on the thread calling scan(); the others are
+ *          persistent threads that sleep until a scan is requested.
+ */
+ProcessScanner::ProcessScanner(int workers)
+{
+    workers = max(workers, 1);
+
+    // The RLIMIT_NOFILE budget is shared between the workers' caches
+    size_t fds_per_worker = ProcFdCache::defaultCapacity() / workers;
+    for (int i = 0; i < workers; i++)
+    {
+        this->workers.push_back(make_unique<Worker>(fds_per_worker));
+    }
+    for (int i = 1; i < workers; i++)
+    {
+        threads.emplace_back(&ProcessScanner::workerLoop, this, i);
+    }
+}
+
+ProcessScanner::~ProcessScanner()
+{
+    {
+        lock_guard<mutex> lock(pool_mutex);
+        stopping = true;
+    }
+    work_ready.notify_all();
+    for (thread &t : threads)
+    {
+        t.join();
+    }
+}
+
+/**
+ * @brief Reads every PID assigned to one worker into its local buffer
+ */
+void ProcessScanner::runWorker(Worker &worker)
+{
+    TRACE_ZONE("scanWorker");
+    worker.cache.beginScan();
+    worker.results.clear();
+
+    for (int pid : worker.pids)
+    {
+        Proc proc = getProcessInfo(worker.cache, pid);
+        if (!proc.name.empty())
+        {
+            if (use_taskstats)
+            {
+                proc.has_taskstats = worker.taskstats.query(pid, proc.delays);
+                proc.has_delays = proc.has_taskstats && delays_valid;
+            }
+            worker.results.push_back(move(proc));
+        }
+    }
+
+    // Release descriptors of processes that are no longer in /proc
+    worker.cache.evictStale();
+}
+
+/**
+ * @brief Body of the persistent worker threads (workers 1..N-1)
+ */
+void ProcessScanner::workerLoop(int index)
+{
+    uint64_t seen_generation = 0;
+    countAllocationsForCollectors(); // scans run on behalf of the sampler
+    nameZoneThread("scan worker");
+
+    while (true)
+    {
+        {
+            unique_lock<mutex> lock(pool_mutex);
+            work_ready.wait(lock, [&]
+                            { return stopping || scan_generation != seen_generation; });
+            if (stopping)
+                return;
+            seen_generation = scan_generation;
+        }
+
+        runWorker(*workers[index]);
+
+        {
+            lock_guard<mutex> lock(pool_mutex);
+            pending_workers--;
+        }
+        work_done.notify_one();
+    }
+}
+
+/**
+ * @brief Scans /proc once, splitting the per-process reads across workers
+ * @return Merged process list (order is unspecified; callers sort by PID)
+ *
+ * PIDs are assigned by pid % workers, so each PID keeps landing on the
+ * same worker and that worker's ProcFdCache keeps its descriptor open.
+ * Each worker parses into its own buffer; the buffers are merged once
+ * every worker has finished.
+ */
+vector<Proc> ProcessScanner::scan()
+{
+    vector<Proc> processes;
+    Worker &first = *workers[0];
+
+    // With the proc connector active the live PID set is already known;
+    // otherwise (or when it needs reseeding) walk /proc
+    if (!takeEventPids(all_pids))
+    {
+        bool resync = processEventsActive();
+        if (resync)
+            beginEventResync();
+        bool listed = first.cache.procDirFd() >= 0 ? listProcPids(first.cache.procDirFd(), all_pids)
+                                                   : listSourcePids(all_pids);
+        if (!listed)
+        {
+            return processes;
+        }
+        if (resync)
+            finishEventResync(all_pids);
+    }
+
+    // Event-driven scans never list /proc, so record the PID set the scan
+    // actually visited; a replay then scans the same processes
+    if (traceRecorderActive())
+    {
+        string listing;
+        for (int pid : all_pids)
+        {
+            listing += to_string(pid);
+            listing += '\0';
+        }
+        recordSourceListing("/proc", listing);
+    }
+
+    use_taskstats = taskstats_enabled;
+    delays_valid = use_taskstats && delayAccountingEnabled();
+
+    size_t worker_count = workers.size();
+    for (auto &worker : workers)
+    {
+        worker->pids.clear();
+    }
+    for (int pid : all_pids)
+    {
+        workers[pid % worker_count]->pids.push_back(pid);
+    }
+
+    if (worker_count > 1)
+    {
+        lock_guard<mutex> lock(pool_mutex);
+        pending_workers = worker_count - 1;
+        scan_generation++;
+    }
+    work_ready.notify_all();
+
+    runWorker(first);
+
+    {
+        unique_lock<mutex> lock(pool_mutex);
+        work_done.wait(lock, [&]
+                       { return pending_workers == 0; });
+    }
+
+    // Merge the thread-local results into one list
+    processes.reserve(all_pids.size());
+    for (auto &worker : workers)
+    {
+        move(worker->results.begin(), worker->results.end(), back_inserter(processes));
+        worker->results.clear();
+    }
+
+    return processes;
+}
+
+/**
+ * @brief Retrieves list of all running processes
+ * @return Vector of Proc structures containing process information
+ * @details Takes the PID list from the proc connector when it is active
+ *          (see procevents.cpp), otherwise enumerates /proc with
+ *          listProcPids(), and reads every process through a ProcessScanner with process_scan_workers workers.
+ *          Each worker keeps its own ProcFdCache, so a process seen on the
+ *          previous scan costs a single pread(). Skips processes that
+ *          disappear during scanning.
+ * @note Not thread-safe; only the sampler thread scans /proc.
+ */
+vector<Proc> getAllProcesses()
+{
+    TRACE_ZONE("getAllProcesses");
+    static ProcessScanner scanner(process_scan_workers);
+    return scanner.scan();
+}
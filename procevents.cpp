@@ -0,0 +1,347 @@
+/**
+ * @file procevents.cpp
+ * @brief Event-driven process lifecycle tracking via the netlink proc connector
+ * @details Subscribes to PROC_EVENT_FORK, PROC_EVENT_EXEC and PROC_EVENT_EXIT
+ *          on a NETLINK_CONNECTOR socket. The set of live processes is then
+ *          maintained incrementally, so a process scan no longer has to walk
+ *          /proc to find out which PIDs exist: it only reads the stat files of
+ *          processes that are known to be alive. Processes that start and exit
+ *          between two scans are still counted and named.
+ *
+ *          Subscribing requires CAP_NET_ADMIN. When the socket cannot be
+ *          opened or bound, startProcessEvents() returns false and the scanner
+ *          keeps enumerating /proc with getdents64 (see process.cpp).
+ * @author Stephen Kisengese
+ * @date 2025
+ */
+
+#include "collector.h"
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <linux/netlink.h>
+#include <linux/connector.h>
+#include <linux/cn_proc.h>
+#include <unordered_set>
+
+// =============================================================================
+// GLOBAL STATE
+// =============================================================================
+
+/**
+ * @brief Whether the proc connector may be used; cleared by --no-proc-events
+ */
+bool process_events_enabled = true;
+
+static int event_socket = -1;                     ///< NETLINK_CONNECTOR socket, -1 when polling
+static thread event_thread;                       ///< Thread reading proc connector messages
+static atomic<bool> events_running(false);        ///< Keeps event_thread alive
+
+static mutex events_mutex;                        ///< Protects everything below
+static unordered_set<int> live_pids;              ///< Processes (thread group leaders) known to be alive
+static unordered_set<int> unscanned_pids;         ///< Forked since the last scan took the PID list
+static unordered_set<int> exited_during_resync;   ///< Exits seen while a /proc walk is in progress
+static map<int, string> unscanned_names;          ///< Names captured at exec for unscanned processes
+static bool resync_needed = true;                 ///< PID set must be rebuilt from a /proc walk
+static bool resync_in_progress = false;           ///< A /proc walk is currently running
+static int scans_since_resync = 0;                ///< Scans served from live_pids since the last walk
+static ProcessEventCounts pending_counts = {};    ///< Events since the last takeProcessEventCounts()
+static vector<string> pending_short_lived;        ///< Names of short-lived processes since the last take
+
+/**
+ * @brief A full /proc walk is forced after this many event-driven scans
+ * @details Guards against any event the kernel dropped without reporting
+ *          ENOBUFS. At the default 3 second interval this is once a minute.
+ */
+static const int RESYNC_INTERVAL_SCANS = 20;
+
+/**
+ * @brief Maximum number of short-lived process names kept per scan interval
+ */
+static const size_t MAX_SHORT_LIVED_NAMES = 16;
+
+// =============================================================================
+// EVENT HANDLING
+// =============================================================================
+
+/**
+ * @brief Reads the command name of a process that just called exec()
+ * @details Done immediately on the event thread because a short-lived
+ *          process may be gone by the time the next scan runs.
+ */
+static string readExecName(int pid)
+{
+    ProcStat stat;
+    if (readProcStat(pid, stat))
+    {
+        return string(stat.comm, stat.comm_len);
+    }
+    return string();
+}
+
+/**
+ * @brief Applies one proc connector event to the live PID set
+ */
+static void handleProcEvent(const proc_event &event)
+{
+    switch (event.what)
+    {
+    case proc_event::PROC_EVENT_FORK:
+    {
+        // New threads share the parent's tgid; only new processes matter here
+        int pid = event.event_data.fork.child_pid;
+        if (pid != event.event_data.fork.child_tgid)
+            return;
+
+        lock_guard<mutex> lock(events_mutex);
+        live_pids.insert(pid);
+        unscanned_pids.insert(pid);
+        pending_counts.forks++;
+        break;
+    }
+    case proc_event::PROC_EVENT_EXEC:
+    {
+        int pid = event.event_data.exec.process_tgid;
+        string name = readExecName(pid);
+
+        lock_guard<mutex> lock(events_mutex);
+        pending_counts.execs++;
+        if (unscanned_pids.count(pid) && !name.empty())
+        {
+            unscanned_names[pid] = name;
+        }
+        break;
+    }
+    case proc_event::PROC_EVENT_EXIT:
+    {
+        int pid = event.event_data.exit.process_pid;
+        if (pid != event.event_data.exit.process_tgid)
+            return;
+
+        lock_guard<mutex> lock(events_mutex);
+        live_pids.erase(pid);
+        pending_counts.exits++;
+        if (resync_in_progress)
+        {
+            exited_during_resync.insert(pid);
+        }
+
+        // Started and exited between two scans: the table never saw it
+        if (unscanned_pids.erase(pid))
+        {
+            pending_counts.short_lived++;
+            auto name = unscanned_names.find(pid);
+            if (name != unscanned_names.end())
+            {
+                if (pending_short_lived.size() < MAX_SHORT_LIVED_NAMES)
+                    pending_short_lived.push_back(name->second);
+                unscanned_names.erase(name);
+            }
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief Body of the event thread: receives and dispatches connector messages
+ * @details Polls with a timeout so stopProcessEvents() is noticed promptly.
+ *          ENOBUFS means the kernel dropped events, so the PID set is marked
+ *          for a rebuild from /proc on the next scan.
+ */
+static void eventLoop()
+{
+    alignas(nlmsghdr) char buf[8192];
+
+    while (events_running.load())
+    {
+        pollfd pfd = {event_socket, POLLIN, 0};
+        if (poll(&pfd, 1, 250) <= 0)
+            continue;
+
+        ssize_t len = recv(event_socket, buf, sizeof(buf), 0);
+        if (len < 0)
+        {
+            if (errno == ENOBUFS)
+            {
+                lock_guard<mutex> lock(events_mutex);
+                resync_needed = true;
+            }
+            continue;
+        }
+
+        for (nlmsghdr *hdr = reinterpret_cast<nlmsghdr *>(buf); NLMSG_OK(hdr, (unsigned)len); hdr = NLMSG_NEXT(hdr, len))
+        {
+            if (hdr->nlmsg_type == NLMSG_ERROR || hdr->nlmsg_type == NLMSG_NOOP)
+                continue;
+
+            const cn_msg *msg = static_cast<const cn_msg *>(NLMSG_DATA(hdr));
+            if (msg->id.idx != CN_IDX_PROC || msg->id.val != CN_VAL_PROC)
+                continue;
+
+            handleProcEvent(*reinterpret_cast<const proc_event *>(msg->data));
+        }
+    }
+}
+
+/**
+ * @brief Sends a PROC_CN_MCAST_LISTEN/IGNORE request on the connector socket
+ */
+static bool sendMulticastOp(proc_cn_mcast_op op)
+{
+    alignas(nlmsghdr) char buf[NLMSG_SPACE(sizeof(cn_msg) + sizeof(proc_cn_mcast_op))] = {};
+
+    nlmsghdr *hdr = reinterpret_cast<nlmsghdr *>(buf);
+    hdr->nlmsg_len = NLMSG_LENGTH(sizeof(cn_msg) + sizeof(proc_cn_mcast_op));
+    hdr->nlmsg_type = NLMSG_DONE;
+    hdr->nlmsg_pid = getpid();
+
+    cn_msg *msg = static_cast<cn_msg *>(NLMSG_DATA(hdr));
+    msg->id.idx = CN_IDX_PROC;
+    msg->id.val = CN_VAL_PROC;
+    msg->len = sizeof(proc_cn_mcast_op);
+    memcpy(msg->data, &op, sizeof(op));
+
+    return send(event_socket, buf, hdr->nlmsg_len, 0) == (ssize_t)hdr->nlmsg_len;
+}
+
+// =============================================================================
+// PUBLIC INTERFACE
+// =============================================================================
+
+/**
+ * @brief Subscribes to process lifecycle events and starts the event thread
+ * @return true if events are active; false if the scanner must keep polling
+ *
+ * @note Typically fails with EPERM without CAP_NET_ADMIN; this is expected
+ *       and silently falls back to enumerating /proc every scan.
+ */
+bool startProcessEvents()
+{
+    if (!process_events_enabled || events_running.load())
+        return events_running.load();
+
+    event_socket = socket(PF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_CONNECTOR);
+    if (event_socket < 0)
+        return false;
+
+    sockaddr_nl addr = {};
+    addr.nl_family = AF_NETLINK;
+    addr.nl_groups = CN_IDX_PROC;
+    addr.nl_pid = 0; // let the kernel assign a port id
+
+    // A larger receive buffer makes ENOBUFS unlikely during fork storms
+    int rcvbuf = 4 * 1024 * 1024;
+    setsockopt(event_socket, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+
+    if (bind(event_socket, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 ||
+        !sendMulticastOp(PROC_CN_MCAST_LISTEN))
+    {
+        close(event_socket);
+        event_socket = -1;
+        return false;
+    }
+
+    {
+        lock_guard<mutex> lock(events_mutex);
+        resync_needed = true; // first scan seeds live_pids from /proc
+    }
+
+    events_running.store(true);
+    event_thread = thread(eventLoop);
+    return true;
+}
+
+/**
+ * @brief Unsubscribes from the proc connector and joins the event thread
+ */
+void stopProcessEvents()
+{
+    if (!events_running.exchange(false))
+        return;
+
+    if (event_thread.joinable())
+    {
+        event_thread.join();
+    }
+    sendMulticastOp(PROC_CN_MCAST_IGNORE);
+    close(event_socket);
+    event_socket = -1;
+}
+
+/**
+ * @brief Whether the PID set is being maintained from connector events
+ */
+bool processEventsActive()
+{
+    return events_running.load();
+}
+
+/**
+ * @brief Hands the scanner the current live PID set
+ * @param pids Receives the live PIDs (cleared first)
+ * @return false if events are inactive or a /proc walk is required first
+ */
+bool takeEventPids(vector<int> &pids)
+{
+    lock_guard<mutex> lock(events_mutex);
+    if (!events_running.load() || resync_needed || scans_since_resync >= RESYNC_INTERVAL_SCANS)
+        return false;
+
+    pids.assign(live_pids.begin(), live_pids.end());
+    unscanned_pids.clear();
+    unscanned_names.clear();
+    scans_since_resync++;
+    return true;
+}
+
+/**
+ * @brief Marks the start of a /proc walk that will reseed the PID set
+ * @details Events keep being applied during the walk; exits are remembered
+ *          so finishEventResync() does not resurrect a PID the walk saw
+ *          just before it exited.
+ */
+void beginEventResync()
+{
+    lock_guard<mutex> lock(events_mutex);
+    resync_in_progress = true;
+    live_pids.clear();
+    exited_during_resync.clear();
+}
+
+/**
+ * @brief Reseeds the live PID set from a completed /proc walk
+ * @param pids PIDs enumerated by the walk
+ */
+void finishEventResync(const vector<int> &pids)
+{
+    lock_guard<mutex> lock(events_mutex);
+    for (int pid : pids)
+    {
+        if (!exited_during_resync.count(pid))
+            live_pids.insert(pid);
+    }
+    exited_during_resync.clear();
+    unscanned_pids.clear();
+    unscanned_names.clear();
+    resync_in_progress = false;
+    resync_needed = false;
+    scans_since_resync = 0;
+}
+
+/**
+ * @brief Returns and resets the event counts gathered since the last call
+ * @param short_lived Receives names of processes that started and exited
+ *        between two scans (at most MAX_SHORT_LIVED_NAMES)
+ */
+ProcessEventCounts takeProcessEventCounts(vector<string> &short_lived)
+{
+    lock_guard<mutex> lock(events_mutex);
+    ProcessEventCounts counts = pending_counts;
+    short_lived.swap(pending_short_lived);
+    pending_short_lived.clear();
+    pending_counts = {};
+    return counts;
+}
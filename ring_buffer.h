@@ -0,0 +1,73 @@
+/**
+ * @file ring_buffer.h
+ * @brief Fixed-capacity ring buffer used for every metric history
+ * @details Appending overwrites the oldest sample in O(1), without shifting
+ *          or allocating. The storage is laid out so it can be handed to
+ *          ImGui::PlotLines() directly: pass data(), size() and offset() as
+ *          values, values_count and values_offset, and ImGui walks the ring
+ *          from the oldest sample to the newest without a copy.
+ * @author Stephen Kisengese
+ * @date 2025
+ */
+
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <cstddef>
+
+template <typename T, size_t N>
+class RingBuffer
+{
+public:
+    static_assert(N > 0, "RingBuffer needs a non-zero capacity");
+
+    /**
+     * @brief Appends a sample, overwriting the oldest one when full
+     */
+    void push(const T &value)
+    {
+        values[head] = value;
+        head = (head + 1) % N;
+        if (count < N)
+            count++;
+    }
+
+    void clear()
+    {
+        head = 0;
+        count = 0;
+    }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    static constexpr size_t capacity() { return N; }
+
+    /**
+     * @brief Raw storage; sample i (0 = oldest) is at (offset() + i) % size()
+     */
+    const T *data() const { return values; }
+
+    /**
+     * @brief Index of the oldest sample in data()
+     * @details Until the buffer first fills, samples occupy [0, size()) in
+     *          order, so the offset is 0.
+     */
+    size_t offset() const { return count < N ? 0 : head; }
+
+    /**
+     * @brief Sample @p i counted from the oldest
+     */
+    const T &operator[](size_t i) const { return values[(offset() + i) % N]; }
+
+    /**
+     * @brief Most recent sample; the buffer must not be empty
+     */
+    const T &back() const { return values[(head + N - 1) % N]; }
+
+private:
+    T values[N] = {};
+    size_t head = 0;  // slot the next push writes
+    size_t count = 0; // number of valid samples, at most N
+};
+
+#endif // RING_BUFFER_H
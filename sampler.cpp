@@ -0,0 +1,217 @@
+/**
+ * @file sampler.cpp
+ * @brief Background sampling thread that owns every data collector
+ * @details The render thread never reads /proc or /sys directly. Instead a
+ *          single sampler thread runs each collector (CPU, thermal, fan,
+ *          memory, process scan, network) on its own interval and publishes
+ *          the results through lock-free TripleBuffers (triple_buffer.h) that
+ *          the render functions read without ever blocking. Histories
+ *          therefore keep filling even while their tab is hidden, and frame
+ *          time no longer depends on /proc I/O latency.
+ * @author Stephen Kisengese
+ * @date 2025
+ */
+
+#include "collector.h"
+
+// =============================================================================
+// COLLECTOR TABLE
+// =============================================================================
+
+/**
+ * @brief One periodic data collector run by the sampler thread
+ * @details The interval is queried every cycle so changes made from the UI
+ *          (e.g. the FPS sliders) take effect without restarting the sampler.
+ */
+struct Collector
+{
+    const char *name;                             ///< Collector name (for diagnostics)
+    void (*run)();                                ///< Function performing one collection
+    float (*interval_ms)();                       ///< Current interval in milliseconds
+    chrono::steady_clock::time_point last_run;    ///< Time of the last completed run
+    CollectorCost cost;                           ///< Accumulated cost, for the overhead panel
+};
+
+static float cpuInterval() { return 1000.0f / max(graph_fps.load(), 1.0f); }
+static float thermalInterval() { return 1000.0f / max(thermal_fps.load(), 1.0f); }
+static float fanInterval() { return 1000.0f / max(fan_fps.load(), 1.0f); }
+static float memoryInterval() { return 1000.0f; }
+static float processInterval() { return 3000.0f; }
+static float systemInfoInterval() { return 2000.0f; }
+static float networkInterval() { return 2000.0f; }
+
+/**
+ * @brief All collectors owned by the sampler, in the order they run when due
+ */
+static Collector collectors[] = {
+    {"cpu", updateCPUHistory, cpuInterval, {}, {}},
+    {"thermal", updateThermalHistory, thermalInterval, {}, {}},
+    {"fan", updateFanHistory, fanInterval, {}, {}},
+    {"memory", updateMemoryInfo, memoryInterval, {}, {}},
+    {"processes", updateProcessSnapshot, processInterval, {}, {}},
+    {"system", updateSystemInfo, systemInfoInterval, {}, {}},
+    {"network", updateNetworkStats, networkInterval, {}, {}},
+};
+
+/**
+ * @brief Runs one collector and adds its wall time, I/O and allocations to its cost
+ */
+static void runCollector(Collector &collector)
+{
+    uint64_t syscalls = collector_syscalls.load(memory_order_relaxed);
+    uint64_t bytes = collector_bytes_read.load(memory_order_relaxed);
+    uint64_t allocations = collectorAllocations();
+    auto start = chrono::steady_clock::now();
+
+    {
+        ZoneScope zone(collector.name);
+        collector.run();
+    }
+
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    CollectorCost &cost = collector.cost;
+    cost.name = collector.name;
+    cost.runs++;
+    cost.last_ms = ms;
+    cost.total_ms += ms;
+    cost.max_ms = max(cost.max_ms, ms);
+    cost.syscalls += collector_syscalls.load(memory_order_relaxed) - syscalls;
+    cost.bytes_read += collector_bytes_read.load(memory_order_relaxed) - bytes;
+    cost.allocations += collectorAllocations() - allocations;
+}
+
+// =============================================================================
+// SAMPLER THREAD
+// =============================================================================
+
+static thread sampler_thread;               ///< Thread running samplerLoop()
+static mutex sampler_mutex;                 ///< Protects sampler_running for the condition variable
+static condition_variable sampler_wakeup;   ///< Signalled to stop the sampler early
+static bool sampler_running = false;        ///< Whether the sampler thread should keep running
+static TripleBuffer<vector<CollectorCost>> cost_buffer; ///< Collector costs as published to the render thread
+static atomic<void (*)()> sample_listener(nullptr);     ///< Told after every cycle that published new data
+
+/**
+ * @brief Upper bound on a single sleep so interval changes are picked up promptly
+ */
+static const chrono::milliseconds max_sampler_sleep(200);
+
+/**
+ * @brief Main loop of the sampler thread
+ * @details Runs every collector whose interval has elapsed, then sleeps until
+ *          the next one is due (or until stopSampler() is called).
+ */
+static void samplerLoop()
+{
+    countAllocationsForCollectors();
+    nameZoneThread("sampler");
+    unique_lock<mutex> lock(sampler_mutex);
+
+    while (sampler_running)
+    {
+        lock.unlock();
+
+        auto now = chrono::steady_clock::now();
+        auto next_due = now + max_sampler_sleep;
+        bool sampled = false;
+
+        for (Collector &collector : collectors)
+        {
+            auto interval = chrono::duration_cast<chrono::steady_clock::duration>(
+                chrono::duration<float, milli>(collector.interval_ms()));
+            auto due = collector.last_run + interval;
+
+            if (now >= due)
+            {
+                runCollector(collector);
+                collector.last_run = now;
+                sampled = true;
+                due = now + interval;
+            }
+            next_due = min(next_due, due);
+        }
+
+        if (sampled)
+        {
+            // Scrapes are served from this page, so they never reach /proc
+            updateMetricsPage();
+
+            vector<CollectorCost> &costs = cost_buffer.writeBuffer();
+            costs.clear();
+            for (const Collector &collector : collectors)
+                costs.push_back(collector.cost);
+            cost_buffer.publish();
+
+            // Lets an idle render loop sleep until there is something new to draw
+            void (*listener)() = sample_listener.load();
+            if (listener != nullptr)
+                listener();
+        }
+
+        lock.lock();
+        sampler_wakeup.wait_until(lock, next_due, []
+                                  { return !sampler_running; });
+    }
+}
+
+/**
+ * @brief Returns the collector costs published after the last sampler cycle
+ * @note Render thread only; the reference stays valid until the next call
+ */
+const vector<CollectorCost> &getCollectorCosts()
+{
+    return cost_buffer.read();
+}
+
+/**
+ * @brief Sets the function called after every sampler cycle that published data
+ * @details The GUI uses it to sleep until there is something new to draw.
+ *          The listener runs on the sampler thread and must not block; pass
+ *          nullptr to remove it.
+ */
+void setSampleListener(void (*listener)())
+{
+    sample_listener.store(listener);
+}
+
+/**
+ * @brief Starts the sampler thread
+ * @details Every collector runs once immediately so the first frame already
+ *          has data to display. Calling this twice has no effect.
+ */
+void startSampler()
+{
+    lock_guard<mutex> lock(sampler_mutex);
+    if (sampler_running)
+        return;
+
+    // Before the first scan, so it already reseeds the event-driven PID set
+    startProcessEvents();
+
+    // Graphs continue from the persistent store, if one is open
+    restoreHistories();
+
+    sampler_running = true;
+    sampler_thread = thread(samplerLoop);
+}
+
+/**
+ * @brief Stops the sampler thread and waits for the current cycle to finish
+ */
+void stopSampler()
+{
+    {
+        lock_guard<mutex> lock(sampler_mutex);
+        if (!sampler_running)
+            return;
+        sampler_running = false;
+    }
+
+    sampler_wakeup.notify_all();
+    if (sampler_thread.joinable())
+    {
+        sampler_thread.join();
+    }
+    stopProcessEvents();
+    closeMetricStore();
+}
@@ -0,0 +1,281 @@
+/**
+ * @file source.cpp
+ * @brief Pluggable backends for the /proc and /sys files the collectors read
+ * @details Collectors always name files by their live absolute path
+ *          ("/proc/stat", "/sys/class/hwmon", ...) and read them through
+ *          readSourceFile() / listSourceDirectory(). The active DataSource
+ *          decides where the bytes come from:
+ *          - FileTreeSource("")      the live system (default)
+ *          - FileTreeSource(root)    a fixture directory laid out like / (--root)
+ *          - ReplaySource            a trace written with --record (--replay)
+ *
+ *          File-backed sources expose their root through fileRoot(), so the
+ *          process scan keeps its cached-descriptor and getdents64() fast
+ *          paths against a fixture exactly as against the live /proc.
+ * @author Stephen Kisengese
+ * @date 2025
+ */
+
+#include "collector.h"
+#include <fcntl.h>
+
+// =============================================================================
+// FILE TREE SOURCE
+// =============================================================================
+
+/**
+ * @brief Serves files from the directory tree rooted at @p root
+ * @param root Prefix prepended to every path; "" reads the live system
+ */
+FileTreeSource::FileTreeSource(string root) : root(move(root))
+{
+    while (!this->root.empty() && this->root.back() == '/')
+        this->root.pop_back();
+}
+
+/**
+ * @brief Reads a whole file into @p out
+ * @details Procfs files report a size of 0, so the file is read until EOF
+ *          rather than sized with fstat().
+ */
+bool FileTreeSource::readFile(const char *path, string &out)
+{
+    out.clear();
+    int fd = open(root.empty() ? path : (root + path).c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        countCollectorIo(1);
+        return false;
+    }
+
+    char buf[4096];
+    ssize_t len;
+    uint64_t reads = 1;
+    while ((len = read(fd, buf, sizeof(buf))) > 0)
+    {
+        out.append(buf, len);
+        reads++;
+    }
+    close(fd);
+    countCollectorIo(reads + 2, out.size()); // open, every read, close
+    return len == 0;
+}
+
+/**
+ * @brief Lists the entries of a directory (without "." and ".."), sorted by name
+ */
+bool FileTreeSource::listDirectory(const char *path, vector<string> &names)
+{
+    names.clear();
+    DIR *dir = opendir(root.empty() ? path : (root + path).c_str());
+    if (dir == nullptr)
+    {
+        countCollectorIo(1);
+        return false;
+    }
+    countCollectorIo(5); // openat, fstat, getdents64 until empty, close
+
+    while (struct dirent *entry = readdir(dir))
+    {
+        if (strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0)
+            names.push_back(entry->d_name);
+    }
+    closedir(dir);
+    sort(names.begin(), names.end());
+    return true;
+}
+
+// =============================================================================
+// REPLAY SOURCE
+// =============================================================================
+
+/**
+ * @brief Loads a trace written by --record
+ * @param path Trace file
+ * @param error Receives a description when loading fails
+ * @return false if the file is missing, truncated or not a trace
+ *
+ * The whole trace is read into memory and indexed by path, so lookups during
+ * replay never touch the disk and are safe from any number of threads.
+ */
+bool ReplaySource::open(const string &path, string &error)
+{
+    ifstream file(path, ios::binary);
+    if (!file.is_open())
+    {
+        error = strerror(errno);
+        return false;
+    }
+    data.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+
+    TraceFileHeader header;
+    if (data.size() < sizeof(header))
+    {
+        error = "file too short for a trace header";
+        return false;
+    }
+    memcpy(&header, data.data(), sizeof(header));
+    if (memcmp(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0 ||
+        header.version != TRACE_VERSION || header.record_header_size != sizeof(TraceRecordHeader))
+    {
+        error = "not a trace written by this version of the monitor";
+        return false;
+    }
+
+    records.clear();
+    duration_ns = 0;
+    size_t offset = sizeof(header);
+    while (offset + sizeof(TraceRecordHeader) <= data.size())
+    {
+        TraceRecordHeader record;
+        memcpy(&record, data.data() + offset, sizeof(record));
+        size_t path_offset = offset + sizeof(record);
+        size_t data_offset = path_offset + record.path_len;
+        if (data_offset + record.data_len > data.size())
+            break; // recording was cut off mid-record
+
+        string record_path(data.data() + path_offset, record.path_len);
+        int64_t time_ns = (int64_t)(record.time_ns - header.start_time_ns);
+        records[record_path].push_back({time_ns, data_offset, record.data_len, record.kind});
+        duration_ns = max(duration_ns, time_ns);
+
+        offset = data_offset + record.data_len;
+    }
+
+    seek(chrono::nanoseconds(0));
+    return true;
+}
+
+/**
+ * @brief Restarts playback at @p offset into the trace
+ */
+void ReplaySource::seek(chrono::nanoseconds offset)
+{
+    seek_offset_ns.store(offset.count());
+    seek_time_ns.store(chrono::steady_clock::now().time_since_epoch().count());
+}
+
+/**
+ * @brief Current playback position, in nanoseconds since recording started
+ * @details Advances with the wall clock and stops at the end of the trace,
+ *          so the last recorded state stays on screen.
+ */
+int64_t ReplaySource::position() const
+{
+    int64_t elapsed = chrono::steady_clock::now().time_since_epoch().count() - seek_time_ns.load();
+    return min(seek_offset_ns.load() + elapsed, duration_ns);
+}
+
+/**
+ * @brief Record of @p path in effect at the current position
+ * @return nullptr if the path was never recorded
+ *
+ * Before the first record of a path, that first record is used, so
+ * collectors that start slightly early still see data.
+ */
+const ReplaySource::Record *ReplaySource::lookup(const char *path) const
+{
+    auto it = records.find(path);
+    if (it == records.end())
+        return nullptr;
+
+    const vector<Record> &history = it->second;
+    int64_t now = position();
+    auto after = upper_bound(history.begin(), history.end(), now,
+                             [](int64_t time, const Record &record)
+                             { return time < record.time_ns; });
+    return after == history.begin() ? &history.front() : &*(after - 1);
+}
+
+bool ReplaySource::readFile(const char *path, string &out)
+{
+    const Record *record = lookup(path);
+    if (record == nullptr || record->kind != TRACE_FILE)
+        return false;
+
+    out.assign(data.data() + record->data_offset, record->data_len);
+    return true;
+}
+
+bool ReplaySource::listDirectory(const char *path, vector<string> &names)
+{
+    names.clear();
+    const Record *record = lookup(path);
+    if (record == nullptr || record->kind != TRACE_DIRECTORY)
+        return false;
+
+    const char *p = data.data() + record->data_offset;
+    const char *end = p + record->data_len;
+    while (p < end)
+    {
+        size_t len = strnlen(p, end - p);
+        names.emplace_back(p, len);
+        p += len + 1;
+    }
+    return true;
+}
+
+// =============================================================================
+// ACTIVE SOURCE
+// =============================================================================
+
+static unique_ptr<DataSource> active_source = make_unique<FileTreeSource>("");
+
+DataSource &dataSource()
+{
+    return *active_source;
+}
+
+/**
+ * @brief Replaces the active source
+ * @note Call before startSampler(); the collectors use the source without
+ *       synchronization.
+ */
+void setDataSource(unique_ptr<DataSource> source)
+{
+    active_source = move(source);
+}
+
+/**
+ * @brief Reads a whole /proc or /sys file from the active source
+ * @param path Live absolute path of the file
+ * @param out Receives the file contents
+ * @return false if the file could not be opened or read
+ * @note The read is captured when --record is active.
+ */
+bool readSourceFile(const char *path, string &out)
+{
+    if (!active_source->readFile(path, out))
+    {
+        recordSourceMissing(path);
+        return false;
+    }
+    recordSourceRead(path, out.data(), out.size());
+    return true;
+}
+
+/**
+ * @brief Lists directory @p path from the active source, sorted by name
+ * @return false if the directory could not be opened
+ * @note The listing is captured when --record is active.
+ */
+bool listSourceDirectory(const char *path, vector<string> &names)
+{
+    if (!active_source->listDirectory(path, names))
+    {
+        recordSourceMissing(path);
+        return false;
+    }
+
+    if (traceRecorderActive())
+    {
+        string listing;
+        for (const string &name : names)
+        {
+            listing += name;
+            listing += '\0';
+        }
+        recordSourceListing(path, listing);
+    }
+    return true;
+}
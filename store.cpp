@@ -0,0 +1,305 @@
+/**
+ * @file store.cpp
+ * @brief Memory-mapped persistent time-series store
+ * @details Metric samples are appended to a file mapped with MAP_SHARED, so
+ *          they survive a restart of the monitor. The file starts with a
+ *          one-page header holding an index entry per series; the rest is
+ *          split into one fixed-capacity ring of fixed-size records per
+ *          series. The file never grows past the configured size cap: once a
+ *          series' ring is full, each append overwrites its oldest record.
+ *
+ *          On startup the header index gives every series' head and count
+ *          directly, so the retained window is usable as soon as the file is
+ *          mapped; nothing has to be scanned or parsed.
+ *
+ * File layout:
+ * @code
+ *   [StoreFileHeader | padding to STORE_HEADER_SIZE]
+ *   [series 0 records: capacity x StoreRecord]
+ *   [series 1 records: capacity x StoreRecord]
+ *   ...
+ * @endcode
+ * @author Stephen Kisengese
+ * @date 2025
+ */
+
+#include "collector.h"
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// =============================================================================
+// FILE FORMAT
+// =============================================================================
+
+static const char STORE_MAGIC[8] = {'S', 'Y', 'S', 'M', 'O', 'N', 'T', 'S'};
+static const uint32_t STORE_VERSION = 1;
+static const size_t STORE_HEADER_SIZE = 4096;
+
+/**
+ * @brief Index entry for one series, stored in the file header
+ */
+struct StoreSeriesIndex
+{
+    char name[32];        ///< Series name, checked when reopening
+    uint64_t data_offset; ///< Byte offset of the first record
+    uint64_t capacity;    ///< Records the ring can hold
+    uint64_t head;        ///< Slot the next append writes
+    uint64_t count;       ///< Valid records, at most capacity
+};
+
+/**
+ * @brief First bytes of the store file
+ */
+struct StoreFileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t series_count;
+    uint64_t file_size;
+    StoreSeriesIndex series[STORE_SERIES_COUNT];
+};
+
+static_assert(sizeof(StoreFileHeader) <= STORE_HEADER_SIZE, "store header must fit in one page");
+
+/**
+ * @brief Series names, indexed by StoreSeries
+ */
+static const char *store_series_names[STORE_SERIES_COUNT] = {
+    "cpu.usage",
+    "thermal.celsius",
+    "fan.rpm",
+    "net.rx_bytes_per_s",
+    "net.tx_bytes_per_s",
+};
+
+// =============================================================================
+// GLOBAL STATE
+// =============================================================================
+
+string metric_store_path;          ///< --store PATH; empty keeps the store disabled
+size_t metric_store_size_mb = 64;  ///< --store-size MB, the on-disk size cap
+
+static char *store_map = nullptr;  ///< Mapping of the whole store file
+static size_t store_map_size = 0;  ///< Length of store_map in bytes
+static int store_fd = -1;          ///< Store file, held open for its flock() while mapped
+
+static StoreFileHeader *storeHeader()
+{
+    return reinterpret_cast<StoreFileHeader *>(store_map);
+}
+
+static StoreRecord *seriesRecords(const StoreSeriesIndex &index)
+{
+    return reinterpret_cast<StoreRecord *>(store_map + index.data_offset);
+}
+
+/**
+ * @brief Whether an existing mapping has the layout this build expects
+ */
+static bool headerMatches(const StoreFileHeader &header, size_t file_size)
+{
+    if (memcmp(header.magic, STORE_MAGIC, sizeof(STORE_MAGIC)) != 0 ||
+        header.version != STORE_VERSION ||
+        header.series_count != STORE_SERIES_COUNT ||
+        header.file_size != file_size)
+        return false;
+
+    for (int i = 0; i < STORE_SERIES_COUNT; i++)
+    {
+        const StoreSeriesIndex &index = header.series[i];
+        if (strncmp(index.name, store_series_names[i], sizeof(index.name)) != 0 ||
+            index.count > index.capacity || index.head >= index.capacity ||
+            index.data_offset + index.capacity * sizeof(StoreRecord) > file_size)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Writes a fresh header that splits the file evenly between series
+ */
+static void initializeHeader(StoreFileHeader &header, size_t file_size)
+{
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, STORE_MAGIC, sizeof(STORE_MAGIC));
+    header.version = STORE_VERSION;
+    header.series_count = STORE_SERIES_COUNT;
+    header.file_size = file_size;
+
+    uint64_t capacity = (file_size - STORE_HEADER_SIZE) / STORE_SERIES_COUNT / sizeof(StoreRecord);
+    for (int i = 0; i < STORE_SERIES_COUNT; i++)
+    {
+        StoreSeriesIndex &index = header.series[i];
+        strncpy(index.name, store_series_names[i], sizeof(index.name) - 1);
+        index.data_offset = STORE_HEADER_SIZE + i * capacity * sizeof(StoreRecord);
+        index.capacity = capacity;
+    }
+}
+
+// =============================================================================
+// PUBLIC INTERFACE
+// =============================================================================
+
+/**
+ * @brief Maps (creating if needed) the store file at @p path
+ * @param path Store file path
+ * @param size_mb On-disk size cap in MiB
+ * @return false if the file cannot be created or mapped
+ *
+ * A file written with the same size cap and series keeps its data. A file
+ * with a different layout (other size cap, older version) is reset, since
+ * records cannot be redistributed between differently sized rings in place.
+ *
+ * The file is locked with flock() for as long as it is mapped, so a second
+ * monitor given the same path fails with EBUSY instead of writing the same
+ * header and rings.
+ */
+bool openMetricStore(const string &path, size_t size_mb)
+{
+    closeMetricStore();
+
+    size_t file_size = max<size_t>(size_mb, 1) * 1024 * 1024;
+    int fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0)
+        return false;
+    if (flock(fd, LOCK_EX | LOCK_NB) != 0)
+    {
+        int error = errno == EWOULDBLOCK ? EBUSY : errno;
+        close(fd);
+        errno = error;
+        return false;
+    }
+
+    struct stat st;
+    bool existing = fstat(fd, &st) == 0 && (size_t)st.st_size == file_size;
+    if (!existing && ftruncate(fd, file_size) != 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    void *map = mmap(nullptr, file_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED)
+    {
+        close(fd);
+        return false;
+    }
+
+    store_fd = fd; // closing it would release the lock
+    store_map = static_cast<char *>(map);
+    store_map_size = file_size;
+
+    if (!existing || !headerMatches(*storeHeader(), file_size))
+    {
+        initializeHeader(*storeHeader(), file_size);
+    }
+    return true;
+}
+
+/**
+ * @brief Flushes and unmaps the store; appends become no-ops
+ */
+void closeMetricStore()
+{
+    if (store_map == nullptr)
+        return;
+
+    msync(store_map, store_map_size, MS_ASYNC);
+    munmap(store_map, store_map_size);
+    close(store_fd); // releases the flock()
+    store_map = nullptr;
+    store_map_size = 0;
+    store_fd = -1;
+}
+
+bool metricStoreOpen()
+{
+    return store_map != nullptr;
+}
+
+/**
+ * @brief Appends one sample to @p series, overwriting the oldest when full
+ * @details The record is written before the index is advanced, so a crash
+ *          mid-append loses at most that sample. Sampler thread only.
+ */
+void appendMetric(StoreSeries series, float value)
+{
+    if (store_map == nullptr)
+        return;
+
+    StoreSeriesIndex &index = storeHeader()->series[series];
+    StoreRecord &record = seriesRecords(index)[index.head];
+    record.time_ns = chrono::duration_cast<chrono::nanoseconds>(
+                         chrono::system_clock::now().time_since_epoch())
+                         .count();
+    record.value = value;
+
+    index.head = (index.head + 1) % index.capacity;
+    if (index.count < index.capacity)
+        index.count++;
+}
+
+/**
+ * @brief Number of records retained for @p series
+ */
+size_t storedMetricCount(StoreSeries series)
+{
+    if (store_map == nullptr)
+        return 0;
+    return storeHeader()->series[series].count;
+}
+
+/**
+ * @brief Record @p i of @p series, counted from the oldest
+ */
+StoreRecord storedMetric(StoreSeries series, size_t i)
+{
+    const StoreSeriesIndex &index = storeHeader()->series[series];
+    size_t oldest = (index.head + index.capacity - index.count) % index.capacity;
+    return seriesRecords(index)[(oldest + i) % index.capacity];
+}
+
+/**
+ * @brief Replays the stored samples of @p series into a rollup history
+ * @param series Series to read
+ * @param history History to fill; samples keep their original age
+ * @param max_age Oldest sample worth replaying (the coarsest tier's span)
+ * @return Number of samples replayed
+ *
+ * Wall-clock timestamps are converted to steady_clock time points relative
+ * to now, so rollup buckets line up with samples taken after the restart.
+ */
+size_t restoreMetricHistory(StoreSeries series, RollupHistory &history, chrono::seconds max_age)
+{
+    size_t count = storedMetricCount(series);
+    if (count == 0)
+        return 0;
+
+    auto wall_now = chrono::duration_cast<chrono::nanoseconds>(chrono::system_clock::now().time_since_epoch());
+    auto steady_now = chrono::steady_clock::now();
+
+    // Records are in time order, so skip straight to the first one in range
+    size_t first = 0;
+    size_t last = count;
+    while (first < last)
+    {
+        size_t mid = first + (last - first) / 2;
+        auto age = wall_now - chrono::nanoseconds(storedMetric(series, mid).time_ns);
+        if (age > max_age)
+            first = mid + 1;
+        else
+            last = mid;
+    }
+
+    for (size_t i = first; i < count; i++)
+    {
+        StoreRecord record = storedMetric(series, i);
+        auto age = wall_now - chrono::nanoseconds(record.time_ns);
+        if (age.count() < 0)
+            continue; // clock stepped back since it was written
+        history.push(record.value, steady_now - chrono::duration_cast<chrono::steady_clock::duration>(age));
+    }
+    return count - first;
+}
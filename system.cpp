@@ -6,43 +6,45 @@
  * - Fan speed and PWM level monitoring
  * - Process counts and system information
  *
- * The application uses ImGui for the graphical interface and reads system information
- * from /proc filesystem and /sys/class hardware monitoring interfaces.
+ * Collection only: values are read from the /proc filesystem and the /sys/class
+ * hardware monitoring interfaces and published for the GUI (system_ui.cpp) or
+ * the headless collector (headless.cpp). Nothing here depends on ImGui.
  *
  * @author Stephen Kisengese
  * @version 1.0
  * @date 2025
  */
 
-#include "header.h"
+#include "collector.h"
 
 /* ========================================================================
  * GLOBAL VARIABLES AND CONFIGURATION
  * ======================================================================== */
 
+// Latest system information snapshot, published by the sampler thread
+static TripleBuffer<SystemInfo> system_info_buffer; ///< Most recent result of getSystemInfo()
+
 // Global variables for CPU graph monitoring
-vector<float> cpu_history;             ///< Historical CPU usage data (max 100 points)
-bool graph_paused = false;             ///< Global pause state for CPU graph updates
-float graph_fps = 10.0f;               ///< Graph update frequency (1-30 FPS)
-float graph_scale = 100.0f;            ///< Y-axis scale for CPU graph (100% or 200%)
-mutex cpu_mutex;                       ///< Mutex for thread-safe CPU data access
+static RollupHistory cpu_history;      ///< CPU usage history with rollup tiers, sampler thread only
+static TripleBuffer<RollupHistory> cpu_history_buffer; ///< cpu_history as published to the render thread
+static CPUStats sampled_cpu_stats = {}; ///< Last /proc/stat reading, sampler thread only
+atomic<bool> graph_paused(false);      ///< Global pause state for CPU graph updates
+atomic<float> graph_fps(10.0f);        ///< Graph update frequency (1-30 FPS)
 atomic<float> current_cpu_usage(0.0f); ///< Current CPU usage percentage
 
 // Global variables for thermal monitoring
-vector<float> thermal_history;           ///< Historical temperature data (max 100 points)
-bool thermal_paused = false;             ///< Global pause state for thermal graph updates
-float thermal_fps = 10.0f;               ///< Thermal update frequency (1-30 FPS)
-float thermal_scale = 100.0f;            ///< Y-axis scale for thermal graph (°C)
-mutex thermal_mutex;                     ///< Mutex for thread-safe thermal data access
+static RollupHistory thermal_history;    ///< Temperature history with rollup tiers, sampler thread only
+static TripleBuffer<RollupHistory> thermal_history_buffer; ///< thermal_history as published to the render thread
+atomic<bool> thermal_paused(false);      ///< Global pause state for thermal graph updates
+atomic<float> thermal_fps(10.0f);        ///< Thermal update frequency (1-30 FPS)
 atomic<float> current_temperature(0.0f); ///< Current temperature in Celsius
 atomic<bool> thermal_available(false);   ///< Whether thermal sensors are available
 
 // Global variables for fan monitoring
-vector<int> fan_speed_history;     ///< Historical fan speed data (max 100 points)
-bool fan_paused = false;           ///< Global pause state for fan graph updates
-float fan_fps = 10.0f;             ///< Fan update frequency (1-30 FPS)
-float fan_scale = 5000.0f;         ///< Y-axis scale for fan graph (RPM)
-mutex fan_mutex;                   ///< Mutex for thread-safe fan data access
+static RollupHistory fan_speed_history; ///< Fan speed history in RPM with rollup tiers, sampler thread only
+static TripleBuffer<RollupHistory> fan_history_buffer; ///< fan_speed_history as published to the render thread
+atomic<bool> fan_paused(false);    ///< Global pause state for fan graph updates
+atomic<float> fan_fps(10.0f);      ///< Fan update frequency (1-30 FPS)
 atomic<int> current_fan_speed(0);  ///< Current fan speed in RPM
 atomic<int> current_fan_level(0);  ///< Current fan PWM level (0-255)
 atomic<bool> fan_active(false);    ///< Whether fan is currently active
@@ -136,13 +138,13 @@ const char *getOsName()
  */
 string getHostname()
 {
-    ifstream file("/proc/sys/kernel/hostname");
+    string contents;
     string hostname;
 
-    if (file.is_open())
+    if (readSourceFile("/proc/sys/kernel/hostname", contents))
     {
+        istringstream file(contents);
         getline(file, hostname);
-        file.close();
 
         // Remove any trailing whitespace/newlines
         hostname.erase(hostname.find_last_not_of(" \t\n\r\f\v") + 1);
@@ -211,7 +213,9 @@ string getUsername()
 CPUStats getCurrentCPUStats()
 {
     CPUStats stats = {0};
-    std::ifstream file("/proc/stat");
+    std::string contents;
+    readSourceFile("/proc/stat", contents);
+    std::istringstream file(contents);
     std::string line;
 
     while (std::getline(file, line))
@@ -228,12 +232,10 @@ CPUStats getCurrentCPUStats()
                 stats.iowait >> stats.irq >> stats.softirq >> stats.steal >>
                 stats.guest >> stats.guestNice;
 
-            file.close();
             return stats;
         }
     }
 
-    file.close();
     return stats;
 }
 
@@ -283,121 +285,46 @@ float calculateCPUUsage(CPUStats prev, CPUStats curr)
 }
 
 /**
- * @brief Retrieves current process counts by state
- *
- * Combines information from /proc/stat (running/blocked counts) with
- * individual process state information from /proc//stat files.
- *
- * @return std::map<std::string, int> containing process counts by state:
- *         - "total": Total number of processes
- *         - "running": Currently running processes
- *         - "blocked": Blocked processes (uninterruptible sleep)
- *         - "sleeping": Sleeping processes (interruptible sleep)
- *         - "zombie": Zombie processes
- *         - "stopped": Stopped processes
- *
- * @note This function may be slow with many processes due to individual stat file reads
+ * @brief Counts processes by state
+ *
+ * Derives the task summary from an already collected process list, so the
+ * counts, the process table and the per-process CPU usage all come from the
+ * same single /proc scan.
+ *
+ * @param processes Process list taken from a ProcessSnapshot
+ * @return ProcessCounts structure containing process counts by state:
+ *         - total: Total number of processes
+ *         - running: Currently running processes
+ *         - sleeping: Sleeping processes (interruptible and uninterruptible)
+ *         - zombie: Zombie processes
+ *         - stopped: Stopped or traced processes
  */
-map<string, int> getProcessCounts()
+ProcessCounts getProcessCounts(const vector<Proc> &processes)
 {
-    map<string, int> counts;
-
-    // Initialize all counters
-    counts["total"] = 0;
-    counts["running"] = 0;
-    counts["blocked"] = 0;
-    counts["sleeping"] = 0;
-    counts["zombie"] = 0;
-    counts["stopped"] = 0;
-
-    // Get running and blocked counts from /proc/stat (more efficient)
-    ifstream file("/proc/stat");
-    string line;
+    ProcessCounts counts = {};
 
-    if (file.is_open())
-    {
-        while (getline(file, line))
-        {
-            if (line.substr(0, 13) == "procs_running")
-            {
-                istringstream iss(line);
-                string label;
-                int running;
-                iss >> label >> running;
-                counts["running"] = running;
-            }
-            else if (line.substr(0, 13) == "procs_blocked")
-            {
-                istringstream iss(line);
-                string label;
-                int blocked;
-                iss >> label >> blocked;
-                counts["blocked"] = blocked;
-            }
-        }
-        file.close();
-    }
-    else
+    for (const Proc &proc : processes)
     {
-        cerr << "Error: Unable to open /proc/stat" << endl;
-        return counts;
-    }
+        counts.total++;
 
-    // Count all processes by examining individual /proc/*/stat files
-    DIR *proc_dir = opendir("/proc");
-    if (proc_dir != nullptr)
-    {
-        struct dirent *entry;
-        while ((entry = readdir(proc_dir)) != nullptr)
+        // Categorize by process state
+        switch (proc.state)
         {
-            // Check if directory name is a number (PID)
-            string dirname = entry->d_name;
-            if (dirname.find_first_not_of("0123456789") == string::npos && !dirname.empty())
-            {
-                string stat_path = "/proc/" + dirname + "/stat";
-                ifstream stat_file(stat_path);
-
-                if (stat_file.is_open())
-                {
-                    string stat_line;
-                    if (getline(stat_file, stat_line))
-                    {
-                        istringstream iss(stat_line);
-                        string token;
-
-                        // Skip PID and command name (can contain spaces and parentheses)
-                        iss >> token; // PID
-                        iss >> token; // Command name in parentheses
-
-                        char state;
-                        iss >> state; // Process state (3rd field)
-
-                        counts["total"]++; // Count every process we can read
-
-                        // Categorize by process state
-                        switch (state)
-                        {
-                        case 'S': // Interruptible sleep
-                        case 'D': // Uninterruptible sleep (blocked)
-                            counts["sleeping"]++;
-                            break;
-                        case 'Z': // Zombie
-                            counts["zombie"]++;
-                            break;
-                        case 'T': // Stopped (signal)
-                        case 't': // Tracing stop
-                            counts["stopped"]++;
-                            break;
-                        case 'R': // Running
-                            // Already counted from /proc/stat
-                            break;
-                        }
-                    }
-                    stat_file.close();
-                }
-            }
+        case 'R': // Running
+            counts.running++;
+            break;
+        case 'S': // Interruptible sleep
+        case 'D': // Uninterruptible sleep (blocked)
+            counts.sleeping++;
+            break;
+        case 'Z': // Zombie
+            counts.zombie++;
+            break;
+        case 'T': // Stopped (signal)
+        case 't': // Tracing stop
+            counts.stopped++;
+            break;
         }
-        closedir(proc_dir);
     }
 
     return counts;
@@ -412,7 +339,7 @@ map<string, int> getProcessCounts()
  * @return SystemInfo structure containing all collected system data
  *
  * @note This function calls multiple system information gathering functions
- * @note Process counting may take some time with many running processes
+ * @note Process counts are copied from the most recent ProcessSnapshot
  */
 SystemInfo getSystemInfo()
 {
@@ -424,25 +351,50 @@ SystemInfo getSystemInfo()
     info.username = getUsername();
     info.cpu_model = CPUinfo();
 
-    // Get current process statistics
-    map<string, int> processCounts = getProcessCounts();
-    info.total_processes = processCounts["total"];
-    info.running_processes = processCounts["running"];
-    info.sleeping_processes = processCounts["sleeping"];
-    info.zombie_processes = processCounts["zombie"];
-    info.stopped_processes = processCounts["stopped"];
+    // Process statistics come from the latest snapshot, no extra /proc walk
+    shared_ptr<const ProcessSnapshot> snapshot = latestProcessSnapshot();
+    const ProcessCounts &counts = snapshot->counts;
+    info.total_processes = counts.total;
+    info.running_processes = counts.running;
+    info.sleeping_processes = counts.sleeping;
+    info.zombie_processes = counts.zombie;
+    info.stopped_processes = counts.stopped;
 
     return info;
 }
 
+/**
+ * @brief Refreshes the cached system information
+ *
+ * Runs getSystemInfo() and publishes the result so the render thread can
+ * display it without touching /proc.
+ *
+ * @note Called by the sampler thread only
+ */
+void updateSystemInfo()
+{
+    system_info_buffer.writeBuffer() = getSystemInfo();
+    system_info_buffer.publish();
+}
+
+/**
+ * @brief Returns the most recent system information published by the sampler
+ * @return Reference valid until the next call (render thread only)
+ */
+const SystemInfo &getCachedSystemInfo()
+{
+    return system_info_buffer.read();
+}
+
 /**
  * @brief Updates CPU usage history data
  *
  * Called periodically to update the CPU usage history buffer.
  * Calculates current CPU usage and adds it to the history if not paused.
- * Maintains a rolling buffer of the last 100 data points.
+ * Keeps the last HISTORY_DEPTH raw points plus 10 s / 1 min / 1 h rollups.
  *
- * @note Thread-safe using cpu_mutex
+ * @note Called by the sampler thread; the history is published through
+ *       cpu_history_buffer, so the render thread never takes a lock
  * @note Skips the first reading to establish baseline
  * @note History is not updated when graph_paused is true
  */
@@ -462,14 +414,11 @@ void updateCPUHistory()
         // Add to history if not paused
         if (!graph_paused)
         {
-            lock_guard<mutex> lock(cpu_mutex);
-            cpu_history.push_back(usage);
+            cpu_history.push(usage, chrono::steady_clock::now());
+            appendMetric(STORE_CPU, usage);
 
-            // Maintain rolling buffer of last 100 points
-            if (cpu_history.size() > 100)
-            {
-                cpu_history.erase(cpu_history.begin());
-            }
+            cpu_history_buffer.writeBuffer() = cpu_history;
+            cpu_history_buffer.publish();
         }
     }
     else
@@ -478,114 +427,72 @@ void updateCPUHistory()
     }
 
     prev_stats = curr_stats;
+    sampled_cpu_stats = curr_stats;
 }
 
 /**
- * @brief Renders the CPU performance monitoring interface
- *
- * Creates a complete ImGui interface for CPU monitoring including:
- * - Control buttons (pause/resume)
- * - FPS and scale adjustment sliders
- * - Real-time CPU usage display
- * - Historical usage graph with overlay
- * - Graph statistics and status
- *
- * @note Uses thread-safe access to shared CPU data
- * @note Graph overlay shows current CPU percentage
- * @note All UI elements are properly laid out using ImGui columns
+ * @brief Returns the /proc/stat totals read by the last updateCPUHistory()
+ * @note Sampler thread only, like latestProcessSnapshot()
  */
-void renderCPUGraph()
+const CPUStats &latestCPUStats()
 {
-    ImGui::Text("CPU Performance Monitor");
-    ImGui::Separator();
-
-    // Control panel with 3 columns
-    ImGui::Columns(3, "cpu_controls", false);
+    return sampled_cpu_stats;
+}
 
-    // Column 1: Pause/Resume button
-    if (ImGui::Button(graph_paused ? "Resume##cpu" : "Pause##cpu", ImVec2(80, 0)))
-    {
-        graph_paused = !graph_paused;
-    }
+/**
+ * @brief Reloads the CPU, thermal, fan and network histories from the metric store
+ * @details Called once by startSampler() before the sampler thread starts,
+ *          so the graphs continue where the previous run stopped. Does
+ *          nothing unless a store was opened with --store.
+ */
+void restoreHistories()
+{
+    if (!metricStoreOpen())
+        return;
 
-    ImGui::NextColumn();
+    // The 1 h tier spans a week; older samples would be dropped anyway
+    chrono::seconds max_age = RollupHistory::bucketWidth(ROLLUP_1H) * 168;
 
-    // Column 2: FPS control slider
-    ImGui::Text("FPS:");
-    ImGui::SetNextItemWidth(300);
-    ImGui::SliderFloat("##cpu_fps", &graph_fps, 1.0f, 30.0f, "%.0f");
+    restoreMetricHistory(STORE_CPU, cpu_history, max_age);
+    cpu_history_buffer.writeBuffer() = cpu_history;
+    cpu_history_buffer.publish();
 
-    ImGui::NextColumn();
+    restoreMetricHistory(STORE_THERMAL, thermal_history, max_age);
+    thermal_history_buffer.writeBuffer() = thermal_history;
+    thermal_history_buffer.publish();
 
-    // Column 3: Y-axis scale control slider
-    ImGui::Text("Y-Scale:");
-    ImGui::SetNextItemWidth(300);
-    ImGui::SliderFloat("##cpu_scale", &graph_scale, 60.0f, 200.0f, "%.0f%%");
+    restoreMetricHistory(STORE_FAN, fan_speed_history, max_age);
+    fan_history_buffer.writeBuffer() = fan_speed_history;
+    fan_history_buffer.publish();
 
-    ImGui::Columns(1);
-    ImGui::Spacing();
+    restoreNetworkHistories(max_age);
+}
 
-    // Display current CPU usage
-    float cpu_percent = current_cpu_usage.load();
-    ImGui::Text("Current CPU Usage: %.1f%%", cpu_percent);
+/**
+ * @brief CPU usage history as last published by updateCPUHistory()
+ * @note Render thread only; the reference stays valid until the next call
+ */
+const RollupHistory &getCPUHistory()
+{
+    return cpu_history_buffer.read();
+}
 
-    // Render graph if data is available
-    if (!cpu_history.empty())
-    {
-        lock_guard<mutex> lock(cpu_mutex);
-
-        // Calculate canvas dimensions
-        ImVec2 canvas_pos = ImGui::GetCursorScreenPos();
-        ImVec2 canvas_size = ImGui::GetContentRegionAvail();
-        canvas_size.y = min(canvas_size.y, 200.0f); // Limit height to 200px
-
-        // Create a copy of the data for plotting to avoid holding the lock too long
-        vector<float> plot_data = cpu_history;
-
-        // Release lock before plotting
-        cpu_mutex.unlock();
-
-        // Plot the line graph
-        ImGui::PlotLines("##cpu_graph",
-                         plot_data.data(),
-                         plot_data.size(),
-                         0,           // values_offset
-                         nullptr,     // overlay_text
-                         0.0f,        // scale_min
-                         graph_scale, // scale_max
-                         canvas_size);
-
-        // Add custom overlay text with background
-        ImDrawList *draw_list = ImGui::GetWindowDrawList();
-        ImVec2 text_pos = ImVec2(canvas_pos.x + 10, canvas_pos.y + 10);
-
-        // Semi-transparent background for overlay text
-        ImVec2 text_size = ImGui::CalcTextSize("CPU: 100.0%");
-        draw_list->AddRectFilled(
-            ImVec2(text_pos.x - 5, text_pos.y - 2),
-            ImVec2(text_pos.x + text_size.x + 5, text_pos.y + text_size.y + 2),
-            IM_COL32(0, 0, 0, 128));
-
-        // White overlay text
-        char overlay_text[32];
-        snprintf(overlay_text, sizeof(overlay_text), "CPU: %.1f%%", cpu_percent);
-        draw_list->AddText(text_pos, IM_COL32(255, 255, 255, 255), overlay_text);
-
-        // Re-acquire lock for any remaining operations
-        cpu_mutex.lock();
-    }
-    else
-    {
-        ImGui::Text("Collecting CPU data...");
-    }
+/**
+ * @brief Temperature history as last published by updateThermalHistory()
+ * @note Render thread only; the reference stays valid until the next call
+ */
+const RollupHistory &getThermalHistory()
+{
+    return thermal_history_buffer.read();
+}
 
-    // Display graph statistics
-    ImGui::Spacing();
-    ImGui::Separator();
-    ImGui::Text("Graph Info:");
-    ImGui::Text("Data Points: %zu/100", cpu_history.size());
-    ImGui::Text("Status: %s", graph_paused ? "Paused" : "Running");
-    ImGui::Text("Update Rate: %.0f FPS", graph_fps);
+/**
+ * @brief Fan speed history as last published by updateFanHistory()
+ * @note Render thread only; the reference stays valid until the next call
+ */
+const RollupHistory &getFanHistory()
+{
+    return fan_history_buffer.read();
 }
 
 /* ========================================================================
@@ -619,11 +526,12 @@ ThermalInfo getThermalInfo()
         "/sys/class/hwmon/hwmon1/temp1_input",
         "/sys/class/hwmon/hwmon2/temp1_input"};
 
+    string contents;
     for (const string &path : thermal_paths)
     {
-        ifstream file(path);
-        if (file.is_open())
+        if (readSourceFile(path.c_str(), contents))
         {
+            istringstream file(contents);
             string temp_str;
             if (getline(file, temp_str))
             {
@@ -633,7 +541,6 @@ ThermalInfo getThermalInfo()
                     // Convert from millicelsius to celsius
                     info.temperature = temp_raw / 1000.0f;
                     info.available = true;
-                    file.close();
                     return info;
                 }
                 catch (const exception &e)
@@ -641,7 +548,6 @@ ThermalInfo getThermalInfo()
                     // Continue to next path if parsing fails
                 }
             }
-            file.close();
         }
     }
 
@@ -653,9 +559,9 @@ ThermalInfo getThermalInfo()
  *
  * Called periodically to update the thermal history buffer.
  * Reads current temperature and adds it to history if not paused.
- * Maintains a rolling buffer of the last 100 data points.
+ * Keeps the last HISTORY_DEPTH raw points plus 10 s / 1 min / 1 h rollups.
  *
- * @note Thread-safe using thermal_mutex
+ * @note Called by the sampler thread; publishes through thermal_history_buffer
  * @note History is not updated when thermal_paused is true
  * @note Updates thermal_available atomic flag
  */
@@ -671,143 +577,15 @@ void updateThermalHistory()
         // Add to history if not paused
         if (!thermal_paused)
         {
-            lock_guard<mutex> lock(thermal_mutex);
-            thermal_history.push_back(thermal_info.temperature);
+            thermal_history.push(thermal_info.temperature, chrono::steady_clock::now());
+            appendMetric(STORE_THERMAL, thermal_info.temperature);
 
-            // Maintain rolling buffer of last 100 points
-            if (thermal_history.size() > 100)
-            {
-                thermal_history.erase(thermal_history.begin());
-            }
+            thermal_history_buffer.writeBuffer() = thermal_history;
+            thermal_history_buffer.publish();
         }
     }
 }
 
-/**
- * @brief Renders the thermal monitoring interface
- *
- * Creates a complete ImGui interface for thermal monitoring including:
- * - Sensor availability check and warning
- * - Control buttons (pause/resume)
- * - FPS and scale adjustment sliders
- * - Real-time temperature display (Celsius and Fahrenheit)
- * - Temperature status warnings (Normal/Caution/Warning)
- * - Historical temperature graph with overlay
- * - Graph statistics and status
- *
- * @note Shows warning message if no thermal sensors are detected
- * @note Temperature warnings: >80°C = Warning, >70°C = Caution, else Normal
- * @note Uses thread-safe access to shared thermal data
- */
-void renderThermalGraph()
-{
-    ImGui::Text("Thermal Monitor");
-    ImGui::Separator();
-
-    // Check if thermal sensors are available
-    if (!thermal_available.load())
-    {
-        ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.0f, 1.0f), "No thermal sensors detected");
-        ImGui::Text("Thermal monitoring is not available on this system.");
-        return;
-    }
-
-    // Control panel with 3 columns
-    ImGui::Columns(3, "thermal_controls", false);
-
-    // Column 1: Pause/Resume button
-    if (ImGui::Button(thermal_paused ? "Resume##thermal" : "Pause##thermal", ImVec2(80, 0)))
-    {
-        thermal_paused = !thermal_paused;
-    }
-
-    ImGui::NextColumn();
-
-    // Column 2: FPS control slider
-    ImGui::Text("FPS:");
-    ImGui::SetNextItemWidth(300);
-    ImGui::SliderFloat("##thermal_fps", &thermal_fps, 1.0f, 30.0f, "%.0f");
-
-    ImGui::NextColumn();
-
-    // Column 3: Y-axis scale control slider
-    ImGui::Text("Y-Scale:");
-    ImGui::SetNextItemWidth(300);
-    ImGui::SliderFloat("##thermal_scale", &thermal_scale, 60.0f, 120.0f, "%.0f°C");
-
-    ImGui::Columns(1);
-    ImGui::Spacing();
-
-    // Display current temperature in both Celsius and Fahrenheit
-    float temp = current_temperature.load();
-    ImGui::Text("Current Temperature: %.1f°C (%.1f°F)", temp, (temp * 9.0f / 5.0f) + 32.0f);
-
-    // Temperature status indication with color coding
-    if (temp > 80.0f)
-    {
-        ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "WARNING: High Temperature!");
-    }
-    else if (temp > 70.0f)
-    {
-        ImGui::TextColored(ImVec4(1.0f, 1.0f, 0.0f, 1.0f), "CAUTION: Elevated Temperature");
-    }
-    else
-    {
-        ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "Temperature Normal");
-    }
-
-    // Render graph if data is available
-    if (!thermal_history.empty())
-    {
-        lock_guard<mutex> lock(thermal_mutex);
-
-        ImVec2 canvas_pos = ImGui::GetCursorScreenPos();
-        ImVec2 canvas_size = ImGui::GetContentRegionAvail();
-        canvas_size.y = min(canvas_size.y, 200.0f);
-
-        // Create copy of data for plotting
-        vector<float> plot_data = thermal_history;
-        thermal_mutex.unlock();
-
-        // Plot the line graph
-        ImGui::PlotLines("##thermal_graph",
-                         plot_data.data(),
-                         plot_data.size(),
-                         0, nullptr, 0.0f, thermal_scale, canvas_size);
-
-        // Add custom overlay text with background
-        ImDrawList *draw_list = ImGui::GetWindowDrawList();
-        ImVec2 text_pos = ImVec2(canvas_pos.x + 10, canvas_pos.y + 10);
-
-        char overlay_text[32];
-        snprintf(overlay_text, sizeof(overlay_text), "%.1f°C", temp);
-        ImVec2 text_size = ImGui::CalcTextSize(overlay_text);
-
-        // Semi-transparent background
-        draw_list->AddRectFilled(
-            ImVec2(text_pos.x - 5, text_pos.y - 2),
-            ImVec2(text_pos.x + text_size.x + 5, text_pos.y + text_size.y + 2),
-            IM_COL32(0, 0, 0, 128));
-
-        // White overlay text
-        draw_list->AddText(text_pos, IM_COL32(255, 255, 255, 255), overlay_text);
-
-        thermal_mutex.lock();
-    }
-    else
-    {
-        ImGui::Text("Collecting thermal data...");
-    }
-
-    // Display graph statistics
-    ImGui::Spacing();
-    ImGui::Separator();
-    ImGui::Text("Graph Info:");
-    ImGui::Text("Data Points: %zu/100", thermal_history.size());
-    ImGui::Text("Status: %s", thermal_paused ? "Paused" : "Running");
-    ImGui::Text("Update Rate: %.0f FPS", thermal_fps);
-}
-
 /* ========================================================================
  * FAN MONITORING FUNCTIONS
  * ======================================================================== */
@@ -832,6 +610,7 @@ void renderThermalGraph()
  */
 FanInfo getFanInfo()
 {
+    TRACE_ZONE("getFanInfo");
     FanInfo info;
     info.available = false;
     info.speed = 0;
@@ -839,79 +618,53 @@ FanInfo getFanInfo()
     info.active = false;
 
     // Search for fan sensors in hwmon directories
-    try
+    vector<string> hwmon_names;
+    listSourceDirectory("/sys/class/hwmon", hwmon_names);
+
+    string contents;
+    for (const string &hwmon_name : hwmon_names)
     {
-        for (const auto &entry : filesystem::directory_iterator("/sys/class/hwmon/"))
+        string hwmon_path = "/sys/class/hwmon/" + hwmon_name;
+
+        // Check for fan speed (fan1_input, fan2_input, etc.)
+        for (int fan_num = 1; fan_num <= 4; fan_num++)
         {
-            if (entry.is_directory())
+            string speed_path = hwmon_path + "/fan" + to_string(fan_num) + "_input";
+            if (!readSourceFile(speed_path.c_str(), contents))
+                continue;
+
+            try
             {
-                string hwmon_path = entry.path().string();
+                info.speed = stoi(contents);
+                info.available = true;
+
+                // Check for fan enable status
+                string enable_path = hwmon_path + "/fan" + to_string(fan_num) + "_enable";
+                if (readSourceFile(enable_path.c_str(), contents))
+                {
+                    info.active = (stoi(contents) == 1);
+                }
+                else
+                {
+                    // If no enable file, assume active if speed > 0
+                    info.active = (info.speed > 0);
+                }
 
-                // Check for fan speed (fan1_input, fan2_input, etc.)
-                for (int fan_num = 1; fan_num <= 4; fan_num++)
+                // Check for PWM level
+                string pwm_path = hwmon_path + "/pwm" + to_string(fan_num);
+                if (readSourceFile(pwm_path.c_str(), contents))
                 {
-                    string speed_path = hwmon_path + "/fan" + to_string(fan_num) + "_input";
-                    ifstream speed_file(speed_path);
-
-                    if (speed_file.is_open())
-                    {
-                        string speed_str;
-                        if (getline(speed_file, speed_str))
-                        {
-                            try
-                            {
-                                info.speed = stoi(speed_str);
-                                info.available = true;
-                                speed_file.close();
-
-                                // Check for fan enable status
-                                string enable_path = hwmon_path + "/fan" + to_string(fan_num) + "_enable";
-                                ifstream enable_file(enable_path);
-                                if (enable_file.is_open())
-                                {
-                                    string enable_str;
-                                    if (getline(enable_file, enable_str))
-                                    {
-                                        info.active = (stoi(enable_str) == 1);
-                                    }
-                                    enable_file.close();
-                                }
-                                else
-                                {
-                                    // If no enable file, assume active if speed > 0
-                                    info.active = (info.speed > 0);
-                                }
-
-                                // Check for PWM level
-                                string pwm_path = hwmon_path + "/pwm" + to_string(fan_num);
-                                ifstream pwm_file(pwm_path);
-                                if (pwm_file.is_open())
-                                {
-                                    string pwm_str;
-                                    if (getline(pwm_file, pwm_str))
-                                    {
-                                        info.level = stoi(pwm_str);
-                                    }
-                                    pwm_file.close();
-                                }
-
-                                return info;
-                            }
-                            catch (const exception &e)
-                            {
-                                // Continue to next fan
-                            }
-                        }
-                        speed_file.close();
-                    }
+                    info.level = stoi(contents);
                 }
+
+                return info;
+            }
+            catch (const exception &e)
+            {
+                // Continue to next fan
             }
         }
     }
-    catch (const exception &e)
-    {
-        // Directory doesn't exist or can't be accessed
-    }
 
     return info;
 }
@@ -921,9 +674,9 @@ FanInfo getFanInfo()
  *
  * Called periodically to update the fan speed history buffer.
  * Reads current fan information and adds speed data to history if not paused.
- * Maintains a rolling buffer of the last 100 data points.
+ * Keeps the last HISTORY_DEPTH raw points plus 10 s / 1 min / 1 h rollups.
  *
- * @note Thread-safe using fan_mutex
+ * @note Called by the sampler thread; publishes through fan_history_buffer
  * @note History is not updated when fan_paused is true
  * @note Updates atomic variables for current fan status
  * @note Updates fan_available, current_fan_speed, current_fan_level, fan_active
@@ -941,194 +694,11 @@ void updateFanHistory()
 
         if (!fan_paused)
         {
-            lock_guard<mutex> lock(fan_mutex);
-            fan_speed_history.push_back(fan_info.speed);
+            fan_speed_history.push(static_cast<float>(fan_info.speed), chrono::steady_clock::now());
+            appendMetric(STORE_FAN, static_cast<float>(fan_info.speed));
 
-            // Keep only last 100 data points
-            if (fan_speed_history.size() > 100)
-            {
-                fan_speed_history.erase(fan_speed_history.begin());
-            }
+            fan_history_buffer.writeBuffer() = fan_speed_history;
+            fan_history_buffer.publish();
         }
     }
 }
-
-/**
- * @brief Renders fan status information display
- *
- * Creates a status display showing current fan information including:
- * - Fan availability check with warning if not detected
- * - Fan active/inactive status with color coding
- * - Current fan speed in RPM
- * - PWM level (0-255) and percentage
- * - Speed classification (High/Medium/Low/Stopped)
- *
- * @note Shows warning message if no fan sensors are detected
- * @note Speed classifications: >4000 RPM = High, >2500 RPM = Medium, >0 RPM = Low, 0 RPM = Stopped
- * @note Uses color coding for different status levels
- * @note All information displayed on single line for compact layout
- */
-void renderFanStatus()
-{
-    if (!fan_available.load())
-    {
-        ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.0f, 1.0f), "No fan sensors detected");
-        ImGui::Text("Fan monitoring is not available on this system.");
-        return;
-    }
-
-    ImGui::Text("Fan Status Information");
-    ImGui::Separator();
-
-    // Fan status, speed, and PWM level on a single line
-    bool is_active = fan_active.load();
-    int speed = current_fan_speed.load();
-    int level = current_fan_level.load();
-    float level_percent = (level / 255.0f) * 100.0f;
-
-    ImGui::Text("Status: ");
-    ImGui::SameLine();
-    if (is_active)
-    {
-        ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "Active");
-    }
-    else
-    {
-        ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "Inactive");
-    }
-
-    ImGui::SameLine();
-    ImGui::Text("  |  Speed: %d RPM", speed);
-
-    ImGui::SameLine();
-    ImGui::Text("  |  PWM: %d (%.1f%%)", level, level_percent);
-
-    // Speed indicator
-    if (speed > 4000)
-    {
-        ImGui::TextColored(ImVec4(1.0f, 1.0f, 0.0f, 1.0f), "High Speed");
-    }
-    else if (speed > 2500)
-    {
-        ImGui::TextColored(ImVec4(0.0f, 1.0f, 1.0f, 1.0f), "Medium Speed");
-    }
-    else if (speed > 0)
-    {
-        ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "Low Speed");
-    }
-    else
-    {
-        ImGui::TextColored(ImVec4(0.5f, 0.5f, 0.5f, 1.0f), "Stopped");
-    }
-}
-
-/**
- * @brief Renders the complete fan monitoring interface
- *
- * Creates a comprehensive ImGui interface for fan monitoring including:
- * - Fan status display (calls renderFanStatus)
- * - Control buttons (pause/resume)
- * - FPS and scale adjustment sliders
- * - Real-time fan speed graph with overlay
- * - Graph statistics and status information
- *
- * @note Returns early if no fan sensors are available
- * @note Graph shows RPM values over time with customizable scale
- * @note Uses thread-safe access to shared fan data
- **/
-void renderFanGraph()
-{
-    ImGui::Text("Fan Speed Monitor");
-    ImGui::Separator();
-
-    // Display fan status first
-    renderFanStatus();
-    if (!fan_available.load())
-    {
-        return;
-    }
-
-    ImGui::Spacing();
-    ImGui::Separator();
-    ImGui::Text("Fan Speed Graph");
-    ImGui::Columns(3, "fan_controls", false); // Control buttons and sliders
-
-    // Pause/Resume button
-    if (ImGui::Button(fan_paused ? "Resume##fan" : "Pause##fan", ImVec2(80, 0)))
-    {
-        fan_paused = !fan_paused;
-    }
-
-    ImGui::NextColumn();
-
-    // FPS control slider
-    ImGui::Text("FPS:");
-    ImGui::SetNextItemWidth(300);
-    ImGui::SliderFloat("##fan_fps", &fan_fps, 1.0f, 30.0f, "%.0f");
-
-    ImGui::NextColumn();
-
-    // Y-axis scale control slider
-    ImGui::Text("Y-Scale:");
-    ImGui::SetNextItemWidth(300);
-    ImGui::SliderFloat("##fan_scale", &fan_scale, 2000.0f, 8000.0f, "%.0f RPM");
-
-    ImGui::Columns(1);
-    ImGui::Spacing();
-
-    // Graph plotting
-    if (!fan_speed_history.empty())
-    {
-        lock_guard<mutex> lock(fan_mutex);
-
-        ImVec2 canvas_pos = ImGui::GetCursorScreenPos();
-        ImVec2 canvas_size = ImGui::GetContentRegionAvail();
-        canvas_size.y = max(min(canvas_size.y, 200.0f), 150.0f);
-        // canvas_size.y = min(canvas_size.y, 200.0f);
-
-        // Convert int vector to float for plotting
-        vector<float> plot_data;
-        plot_data.reserve(fan_speed_history.size());
-        for (int speed : fan_speed_history)
-        {
-            plot_data.push_back(static_cast<float>(speed));
-        }
-
-        fan_mutex.unlock();
-
-        // Plot the graph
-        ImGui::PlotLines("##fan_graph",
-                         plot_data.data(),
-                         plot_data.size(),
-                         0, nullptr, 0.0f, fan_scale, canvas_size);
-
-        // Add overlay text on the graph
-        ImDrawList *draw_list = ImGui::GetWindowDrawList();
-        ImVec2 text_pos = ImVec2(canvas_pos.x + 10, canvas_pos.y + 10);
-
-        char overlay_text[32];
-        snprintf(overlay_text, sizeof(overlay_text), "%d RPM", current_fan_speed.load());
-        ImVec2 text_size = ImGui::CalcTextSize(overlay_text);
-
-        draw_list->AddRectFilled(
-            ImVec2(text_pos.x - 5, text_pos.y - 2),
-            ImVec2(text_pos.x + text_size.x + 5, text_pos.y + text_size.y + 2),
-            IM_COL32(0, 0, 0, 128));
-        // Draw the overlay text
-        draw_list->AddText(text_pos, IM_COL32(255, 255, 255, 255), overlay_text);
-
-        fan_mutex.lock();
-    }
-    else
-    {
-        ImGui::Text("Collecting fan data...");
-    }
-
-    // Graph statistics
-    ImGui::Spacing();
-    ImGui::Separator();
-    ImGui::Text("Graph Info:");
-    ImGui::Text("Data Points: %zu/100", fan_speed_history.size());
-    ImGui::Text("Status: %s", fan_paused ? "Paused" : "Running");
-    ImGui::Text("Update Rate: %.0f FPS", fan_fps);
-}
\ No newline at end of file
@@ -0,0 +1,430 @@
+/**
+ * @file system_ui.cpp
+ * @brief ImGui views of the CPU, thermal and fan collectors
+ * @details Draws the graphs and status panels of the System window from the
+ *          values and histories published by system.cpp. Only the render
+ *          thread calls into this file; the collectors never depend on it,
+ *          so the headless build leaves it out.
+ * @author Stephen Kisengese
+ * @date 2025
+ */
+
+#include "header.h"
+
+/* ========================================================================
+ * GRAPH SETTINGS
+ * ======================================================================== */
+
+static int cpu_window = 0;         ///< Selected CPU graph window (see history_ui.cpp)
+float graph_scale = 100.0f;        ///< Y-axis scale for CPU graph (100% or 200%)
+static int thermal_window = 0;     ///< Selected thermal graph window (see history_ui.cpp)
+float thermal_scale = 100.0f;      ///< Y-axis scale for thermal graph (°C)
+static int fan_window = 0;         ///< Selected fan graph window (see history_ui.cpp)
+float fan_scale = 5000.0f;         ///< Y-axis scale for fan graph (RPM)
+
+/* ========================================================================
+ * GRAPH RENDERING FUNCTIONS
+ * ======================================================================== */
+
+/**
+ * @brief Renders the CPU performance monitoring interface
+ *
+ * Creates a complete ImGui interface for CPU monitoring including:
+ * - Control buttons (pause/resume)
+ * - FPS and scale adjustment sliders
+ * - Real-time CPU usage display
+ * - Historical usage graph with overlay
+ * - Graph statistics and status
+ *
+ * @note Reads the latest published history without locking
+ * @note Graph overlay shows current CPU percentage
+ * @note All UI elements are properly laid out using ImGui columns
+ */
+void renderCPUGraph()
+{
+    ImGui::Text("CPU Performance Monitor");
+    ImGui::Separator();
+
+    // Control panel with 3 columns
+    ImGui::Columns(3, "cpu_controls", false);
+
+    // Column 1: Pause/Resume button
+    if (ImGui::Button(graph_paused.load() ? "Resume##cpu" : "Pause##cpu", ImVec2(80, 0)))
+    {
+        graph_paused.store(!graph_paused.load());
+    }
+
+    ImGui::NextColumn();
+
+    // Column 2: FPS control slider
+    ImGui::Text("FPS:");
+    ImGui::SetNextItemWidth(300);
+    float cpu_fps_value = graph_fps.load(); // sampler thread reads the atomic
+    if (ImGui::SliderFloat("##cpu_fps", &cpu_fps_value, 1.0f, 30.0f, "%.0f"))
+    {
+        graph_fps.store(cpu_fps_value);
+    }
+
+    ImGui::NextColumn();
+
+    // Column 3: Y-axis scale control slider
+    ImGui::Text("Y-Scale:");
+    ImGui::SetNextItemWidth(300);
+    ImGui::SliderFloat("##cpu_scale", &graph_scale, 60.0f, 200.0f, "%.0f%%");
+
+    ImGui::Columns(1);
+    ImGui::Spacing();
+
+    // Display current CPU usage
+    float cpu_percent = current_cpu_usage.load();
+    ImGui::Text("Current CPU Usage: %.1f%%", cpu_percent);
+
+    ImGui::Text("Window:");
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(150);
+    renderHistoryWindowCombo("##cpu_window", cpu_window);
+
+    // Render graph if data is available
+    const RollupHistory &history = getCPUHistory();
+    size_t points = 0;
+    if (!history.raw().empty())
+    {
+        // Calculate canvas dimensions
+        ImVec2 canvas_pos = ImGui::GetCursorScreenPos();
+        ImVec2 canvas_size = ImGui::GetContentRegionAvail();
+        canvas_size.y = min(canvas_size.y, 200.0f); // Limit height to 200px
+
+        // Plot the selected window in place (raw ring or rollup buckets)
+        points = renderHistoryPlot("##cpu_graph", history, cpu_window, graph_scale, canvas_size);
+
+        // Add custom overlay text with background
+        ImDrawList *draw_list = ImGui::GetWindowDrawList();
+        ImVec2 text_pos = ImVec2(canvas_pos.x + 10, canvas_pos.y + 10);
+
+        // Semi-transparent background for overlay text
+        ImVec2 text_size = ImGui::CalcTextSize("CPU: 100.0%");
+        draw_list->AddRectFilled(
+            ImVec2(text_pos.x - 5, text_pos.y - 2),
+            ImVec2(text_pos.x + text_size.x + 5, text_pos.y + text_size.y + 2),
+            IM_COL32(0, 0, 0, 128));
+
+        // White overlay text
+        char overlay_text[32];
+        snprintf(overlay_text, sizeof(overlay_text), "CPU: %.1f%%", cpu_percent);
+        draw_list->AddText(text_pos, IM_COL32(255, 255, 255, 255), overlay_text);
+    }
+    else
+    {
+        ImGui::Text("Collecting CPU data...");
+    }
+
+    // Display graph statistics
+    ImGui::Spacing();
+    ImGui::Separator();
+    ImGui::Text("Graph Info:");
+    ImGui::Text("Data Points: %zu", points);
+    ImGui::Text("Status: %s", graph_paused.load() ? "Paused" : "Running");
+    ImGui::Text("Update Rate: %.0f FPS", graph_fps.load());
+}
+
+
+/**
+ * @brief Renders the thermal monitoring interface
+ *
+ * Creates a complete ImGui interface for thermal monitoring including:
+ * - Sensor availability check and warning
+ * - Control buttons (pause/resume)
+ * - FPS and scale adjustment sliders
+ * - Real-time temperature display (Celsius and Fahrenheit)
+ * - Temperature status warnings (Normal/Caution/Warning)
+ * - Historical temperature graph with overlay
+ * - Graph statistics and status
+ *
+ * @note Shows warning message if no thermal sensors are detected
+ * @note Temperature warnings: >80°C = Warning, >70°C = Caution, else Normal
+ * @note Reads the latest published history without locking
+ */
+void renderThermalGraph()
+{
+    ImGui::Text("Thermal Monitor");
+    ImGui::Separator();
+
+    // Check if thermal sensors are available
+    if (!thermal_available.load())
+    {
+        ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.0f, 1.0f), "No thermal sensors detected");
+        ImGui::Text("Thermal monitoring is not available on this system.");
+        return;
+    }
+
+    // Control panel with 3 columns
+    ImGui::Columns(3, "thermal_controls", false);
+
+    // Column 1: Pause/Resume button
+    if (ImGui::Button(thermal_paused.load() ? "Resume##thermal" : "Pause##thermal", ImVec2(80, 0)))
+    {
+        thermal_paused.store(!thermal_paused.load());
+    }
+
+    ImGui::NextColumn();
+
+    // Column 2: FPS control slider
+    ImGui::Text("FPS:");
+    ImGui::SetNextItemWidth(300);
+    float thermal_fps_value = thermal_fps.load(); // sampler thread reads the atomic
+    if (ImGui::SliderFloat("##thermal_fps", &thermal_fps_value, 1.0f, 30.0f, "%.0f"))
+    {
+        thermal_fps.store(thermal_fps_value);
+    }
+
+    ImGui::NextColumn();
+
+    // Column 3: Y-axis scale control slider
+    ImGui::Text("Y-Scale:");
+    ImGui::SetNextItemWidth(300);
+    ImGui::SliderFloat("##thermal_scale", &thermal_scale, 60.0f, 120.0f, "%.0f°C");
+
+    ImGui::Columns(1);
+    ImGui::Spacing();
+
+    // Display current temperature in both Celsius and Fahrenheit
+    float temp = current_temperature.load();
+    ImGui::Text("Current Temperature: %.1f°C (%.1f°F)", temp, (temp * 9.0f / 5.0f) + 32.0f);
+
+    // Temperature status indication with color coding
+    if (temp > 80.0f)
+    {
+        ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "WARNING: High Temperature!");
+    }
+    else if (temp > 70.0f)
+    {
+        ImGui::TextColored(ImVec4(1.0f, 1.0f, 0.0f, 1.0f), "CAUTION: Elevated Temperature");
+    }
+    else
+    {
+        ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "Temperature Normal");
+    }
+
+    ImGui::Text("Window:");
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(150);
+    renderHistoryWindowCombo("##thermal_window", thermal_window);
+
+    // Render graph if data is available
+    const RollupHistory &history = getThermalHistory();
+    size_t points = 0;
+    if (!history.raw().empty())
+    {
+        ImVec2 canvas_pos = ImGui::GetCursorScreenPos();
+        ImVec2 canvas_size = ImGui::GetContentRegionAvail();
+        canvas_size.y = min(canvas_size.y, 200.0f);
+
+        // Plot the selected window in place (raw ring or rollup buckets)
+        points = renderHistoryPlot("##thermal_graph", history, thermal_window, thermal_scale, canvas_size);
+
+        // Add custom overlay text with background
+        ImDrawList *draw_list = ImGui::GetWindowDrawList();
+        ImVec2 text_pos = ImVec2(canvas_pos.x + 10, canvas_pos.y + 10);
+
+        char overlay_text[32];
+        snprintf(overlay_text, sizeof(overlay_text), "%.1f°C", temp);
+        ImVec2 text_size = ImGui::CalcTextSize(overlay_text);
+
+        // Semi-transparent background
+        draw_list->AddRectFilled(
+            ImVec2(text_pos.x - 5, text_pos.y - 2),
+            ImVec2(text_pos.x + text_size.x + 5, text_pos.y + text_size.y + 2),
+            IM_COL32(0, 0, 0, 128));
+
+        // White overlay text
+        draw_list->AddText(text_pos, IM_COL32(255, 255, 255, 255), overlay_text);
+    }
+    else
+    {
+        ImGui::Text("Collecting thermal data...");
+    }
+
+    // Display graph statistics
+    ImGui::Spacing();
+    ImGui::Separator();
+    ImGui::Text("Graph Info:");
+    ImGui::Text("Data Points: %zu", points);
+    ImGui::Text("Status: %s", thermal_paused.load() ? "Paused" : "Running");
+    ImGui::Text("Update Rate: %.0f FPS", thermal_fps.load());
+}
+
+
+/**
+ * @brief Renders fan status information display
+ *
+ * Creates a status display showing current fan information including:
+ * - Fan availability check with warning if not detected
+ * - Fan active/inactive status with color coding
+ * - Current fan speed in RPM
+ * - PWM level (0-255) and percentage
+ * - Speed classification (High/Medium/Low/Stopped)
+ *
+ * @note Shows warning message if no fan sensors are detected
+ * @note Speed classifications: >4000 RPM = High, >2500 RPM = Medium, >0 RPM = Low, 0 RPM = Stopped
+ * @note Uses color coding for different status levels
+ * @note All information displayed on single line for compact layout
+ */
+void renderFanStatus()
+{
+    if (!fan_available.load())
+    {
+        ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.0f, 1.0f), "No fan sensors detected");
+        ImGui::Text("Fan monitoring is not available on this system.");
+        return;
+    }
+
+    ImGui::Text("Fan Status Information");
+    ImGui::Separator();
+
+    // Fan status, speed, and PWM level on a single line
+    bool is_active = fan_active.load();
+    int speed = current_fan_speed.load();
+    int level = current_fan_level.load();
+    float level_percent = (level / 255.0f) * 100.0f;
+
+    ImGui::Text("Status: ");
+    ImGui::SameLine();
+    if (is_active)
+    {
+        ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "Active");
+    }
+    else
+    {
+        ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "Inactive");
+    }
+
+    ImGui::SameLine();
+    ImGui::Text("  |  Speed: %d RPM", speed);
+
+    ImGui::SameLine();
+    ImGui::Text("  |  PWM: %d (%.1f%%)", level, level_percent);
+
+    // Speed indicator
+    if (speed > 4000)
+    {
+        ImGui::TextColored(ImVec4(1.0f, 1.0f, 0.0f, 1.0f), "High Speed");
+    }
+    else if (speed > 2500)
+    {
+        ImGui::TextColored(ImVec4(0.0f, 1.0f, 1.0f, 1.0f), "Medium Speed");
+    }
+    else if (speed > 0)
+    {
+        ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "Low Speed");
+    }
+    else
+    {
+        ImGui::TextColored(ImVec4(0.5f, 0.5f, 0.5f, 1.0f), "Stopped");
+    }
+}
+
+
+/**
+ * @brief Renders the complete fan monitoring interface
+ *
+ * Creates a comprehensive ImGui interface for fan monitoring including:
+ * - Fan status display (calls renderFanStatus)
+ * - Control buttons (pause/resume)
+ * - FPS and scale adjustment sliders
+ * - Real-time fan speed graph with overlay
+ * - Graph statistics and status information
+ *
+ * @note Returns early if no fan sensors are available
+ * @note Graph shows RPM values over time with customizable scale
+ * @note Reads the latest published history without locking
+ **/
+void renderFanGraph()
+{
+    ImGui::Text("Fan Speed Monitor");
+    ImGui::Separator();
+
+    // Display fan status first
+    renderFanStatus();
+    if (!fan_available.load())
+    {
+        return;
+    }
+
+    ImGui::Spacing();
+    ImGui::Separator();
+    ImGui::Text("Fan Speed Graph");
+    ImGui::Columns(3, "fan_controls", false); // Control buttons and sliders
+
+    // Pause/Resume button
+    if (ImGui::Button(fan_paused.load() ? "Resume##fan" : "Pause##fan", ImVec2(80, 0)))
+    {
+        fan_paused.store(!fan_paused.load());
+    }
+
+    ImGui::NextColumn();
+
+    // FPS control slider
+    ImGui::Text("FPS:");
+    ImGui::SetNextItemWidth(300);
+    float fan_fps_value = fan_fps.load(); // sampler thread reads the atomic
+    if (ImGui::SliderFloat("##fan_fps", &fan_fps_value, 1.0f, 30.0f, "%.0f"))
+    {
+        fan_fps.store(fan_fps_value);
+    }
+
+    ImGui::NextColumn();
+
+    // Y-axis scale control slider
+    ImGui::Text("Y-Scale:");
+    ImGui::SetNextItemWidth(300);
+    ImGui::SliderFloat("##fan_scale", &fan_scale, 2000.0f, 8000.0f, "%.0f RPM");
+
+    ImGui::Columns(1);
+    ImGui::Spacing();
+
+    ImGui::Text("Window:");
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(150);
+    renderHistoryWindowCombo("##fan_window", fan_window);
+
+    // Graph plotting
+    const RollupHistory &fan_history = getFanHistory();
+    size_t points = 0;
+    if (!fan_history.raw().empty())
+    {
+        ImVec2 canvas_pos = ImGui::GetCursorScreenPos();
+        ImVec2 canvas_size = ImGui::GetContentRegionAvail();
+        canvas_size.y = max(min(canvas_size.y, 200.0f), 150.0f);
+        // canvas_size.y = min(canvas_size.y, 200.0f);
+
+        // Plot the selected window in place (raw ring or rollup buckets)
+        points = renderHistoryPlot("##fan_graph", fan_history, fan_window, fan_scale, canvas_size);
+
+        // Add overlay text on the graph
+        ImDrawList *draw_list = ImGui::GetWindowDrawList();
+        ImVec2 text_pos = ImVec2(canvas_pos.x + 10, canvas_pos.y + 10);
+
+        char overlay_text[32];
+        snprintf(overlay_text, sizeof(overlay_text), "%d RPM", current_fan_speed.load());
+        ImVec2 text_size = ImGui::CalcTextSize(overlay_text);
+
+        draw_list->AddRectFilled(
+            ImVec2(text_pos.x - 5, text_pos.y - 2),
+            ImVec2(text_pos.x + text_size.x + 5, text_pos.y + text_size.y + 2),
+            IM_COL32(0, 0, 0, 128));
+        // Draw the overlay text
+        draw_list->AddText(text_pos, IM_COL32(255, 255, 255, 255), overlay_text);
+    }
+    else
+    {
+        ImGui::Text("Collecting fan data...");
+    }
+
+    // Graph statistics
+    ImGui::Spacing();
+    ImGui::Separator();
+    ImGui::Text("Graph Info:");
+    ImGui::Text("Data Points: %zu", points);
+    ImGui::Text("Status: %s", fan_paused.load() ? "Paused" : "Running");
+    ImGui::Text("Update Rate: %.0f FPS", fan_fps.load());
+}
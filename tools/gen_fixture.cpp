@@ -0,0 +1,248 @@
+/**
+ * @file gen_fixture.cpp
+ * @brief Synthesizes a /proc and /sys fixture tree for `monitor --root`
+ * @details Writes every file the collectors read, laid out under the output
+ *          directory exactly as on a live system:
+ *          - proc/stat, proc/meminfo, proc/net/dev, proc/sys/kernel/hostname
+ *          - proc/[pid]/stat for --processes processes
+ *          - sys/class/thermal/thermal_zone0/temp
+ *          - sys/class/hwmon/hwmon0/{fan1_input,fan1_enable,pwm1,temp1_input}
+ *
+ *          Output depends only on the options (and the standard library's
+ *          random distributions), so the same command reproduces the same tree. Counters grow linearly with
+ *          --tick, so writing tick 1 over a tick 0 tree gives the CPU%
+ *          computations a realistic interval to work on.
+ *
+ * Build and run:
+ *   make gen_fixture
+ *   ./gen_fixture --processes 100000 /tmp/fixture-100k
+ *   ./monitor --root /tmp/fixture-100k
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <random>
+#include <sys/stat.h>
+
+using namespace std;
+
+struct FixtureOptions
+{
+    int processes = 100000;
+    int interfaces = 4;
+    int cpus = 8;
+    long tick = 0;        ///< Counter position; one tick is one second of activity
+    unsigned seed = 1;
+    string root;
+};
+
+/**
+ * @brief Command names drawn from for synthetic processes
+ * @details Includes names with spaces and parentheses, which the stat parser
+ *          must delimit by the last ')'.
+ */
+static const char *const process_names[] = {
+    "systemd", "kworker/0:1H", "bash", "sshd", "postgres", "nginx", "python3",
+    "Web Content", "(sd-pam)", "java", "node", "containerd-shim", "chrome",
+    "rcu_sched", "ksoftirqd/3", "Xorg", "pipewire", "gnome-shell", "cc1plus",
+};
+
+// =============================================================================
+// FILE HELPERS
+// =============================================================================
+
+static bool makeDirectories(const string &path)
+{
+    for (size_t slash = path.find('/', 1); ; slash = path.find('/', slash + 1))
+    {
+        string prefix = path.substr(0, slash);
+        if (mkdir(prefix.c_str(), 0755) != 0 && errno != EEXIST)
+        {
+            fprintf(stderr, "mkdir %s: %s\n", prefix.c_str(), strerror(errno));
+            return false;
+        }
+        if (slash == string::npos)
+            return true;
+    }
+}
+
+static bool writeFile(const string &path, const string &contents)
+{
+    FILE *file = fopen(path.c_str(), "w");
+    if (file == nullptr)
+    {
+        fprintf(stderr, "write %s: %s\n", path.c_str(), strerror(errno));
+        return false;
+    }
+    fwrite(contents.data(), 1, contents.size(), file);
+    fclose(file);
+    return true;
+}
+
+static string format(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+static string format(const char *fmt, ...)
+{
+    char buf[1024];
+    va_list args;
+    va_start(args, fmt);
+    int len = vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    return string(buf, min<size_t>(len, sizeof(buf) - 1));
+}
+
+// =============================================================================
+// GENERATORS
+// =============================================================================
+
+static bool writeSystemFiles(const FixtureOptions &options)
+{
+    const string &root = options.root;
+    long t = options.tick;
+
+    // Aggregate line first, then one line per CPU (about 30% busy)
+    string stat;
+    long user = 100000 + 25 * options.cpus * t, system = 30000 + 5 * options.cpus * t;
+    long idle = 500000 + 70 * options.cpus * t;
+    stat += format("cpu  %ld 120 %ld %ld 800 0 300 0 0 0\n", user, system, idle);
+    for (int cpu = 0; cpu < options.cpus; cpu++)
+    {
+        stat += format("cpu%d %ld 15 %ld %ld 100 0 40 0 0 0\n", cpu,
+                       user / options.cpus, system / options.cpus, idle / options.cpus);
+    }
+    stat += format("ctxt %ld\nbtime 1700000000\nprocesses %d\nprocs_running 3\nprocs_blocked 0\n",
+                   90000000 + 4000 * t, options.processes + 1000);
+
+    string meminfo = format("MemTotal:       65536000 kB\n"
+                            "MemFree:        20000000 kB\n"
+                            "MemAvailable:   %ld kB\n"
+                            "Buffers:          500000 kB\n"
+                            "Cached:         15000000 kB\n"
+                            "SwapTotal:       8388604 kB\n"
+                            "SwapFree:        8000000 kB\n",
+                            30000000 + (t % 60) * 10000);
+
+    string net = "Inter-|   Receive                                                |  Transmit\n"
+                 " face |bytes    packets errs drop fifo frame compressed multicast|bytes    packets errs drop fifo colls carrier compressed\n";
+    for (int i = 0; i < options.interfaces; i++)
+    {
+        string name = i == 0 ? "lo" : format("eth%d", i - 1);
+        long rx = 1000000000L * (i + 1) + 1250000L * t, tx = 400000000L * (i + 1) + 500000L * t;
+        net += format("%6s: %ld %ld 0 0 0 0 0 0 %ld %ld 0 0 0 0 0 0\n",
+                      name.c_str(), rx, rx / 1000, tx, tx / 1000);
+    }
+
+    string thermal = root + "/sys/class/thermal/thermal_zone0";
+    string hwmon = root + "/sys/class/hwmon/hwmon0";
+    return makeDirectories(root + "/proc/net") && makeDirectories(root + "/proc/sys/kernel") &&
+           makeDirectories(thermal) && makeDirectories(hwmon) &&
+           writeFile(root + "/proc/stat", stat) &&
+           writeFile(root + "/proc/meminfo", meminfo) &&
+           writeFile(root + "/proc/net/dev", net) &&
+           writeFile(root + "/proc/sys/kernel/hostname", "fixture\n") &&
+           writeFile(thermal + "/temp", format("%ld\n", 45000 + (t % 20) * 500)) &&
+           writeFile(hwmon + "/temp1_input", format("%ld\n", 47000 + (t % 20) * 500)) &&
+           writeFile(hwmon + "/fan1_input", format("%ld\n", 2100 + (t % 10) * 15)) &&
+           writeFile(hwmon + "/fan1_enable", "1\n") &&
+           writeFile(hwmon + "/pwm1", "128\n");
+}
+
+/**
+ * @brief Writes proc/[pid]/stat for every synthetic process
+ * @details PIDs start at 1 and are spread over a sparse range like a busy
+ *          host's. Each process gets a fixed per-tick CPU rate drawn from a
+ *          skewed distribution, so most are idle and a few are busy.
+ */
+static bool writeProcesses(const FixtureOptions &options)
+{
+    mt19937 rng(options.seed);
+    uniform_int_distribution<int> pid_gap(1, 3);
+    uniform_int_distribution<int> name_index(0, sizeof(process_names) / sizeof(process_names[0]) - 1);
+    exponential_distribution<double> cpu_rate(8.0); // ticks per second, mean 0.125
+    uniform_int_distribution<long> rss_pages(200, 200000);
+    const char states[] = "SSSSSSSSRDIZT";
+    uniform_int_distribution<int> state_index(0, sizeof(states) - 2);
+
+    int pid = 0;
+    for (int i = 0; i < options.processes; i++)
+    {
+        pid += pid_gap(rng);
+        const char *name = process_names[name_index(rng)];
+        double rate = cpu_rate(rng);
+        long rss = rss_pages(rng);
+        char state = states[state_index(rng)];
+
+        long utime = (long)(rate * 80 * options.tick) + i % 997;
+        long stime = (long)(rate * 20 * options.tick) + i % 331;
+        long starttime = 1000 + i * 3L;
+        long vsize = rss * 4096 * 3;
+
+        string dir = options.root + "/proc/" + to_string(pid);
+        if (mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST)
+        {
+            fprintf(stderr, "mkdir %s: %s\n", dir.c_str(), strerror(errno));
+            return false;
+        }
+
+        string stat = format("%d (%s) %c 1 %d %d 0 -1 4194560 %d 0 12 0 %ld %ld 0 0 20 0 1 0 %ld %ld %ld "
+                             "18446744073709551615 1 1 0 0 0 0 0 4096 0 0 0 0 17 %d 0 0 0 0 0 0 0 0 0 0 0 0 0\n",
+                             pid, name, state, pid, pid, 1500 + i % 4000, utime, stime,
+                             starttime, vsize, rss, i % options.cpus);
+        if (!writeFile(dir + "/stat", stat))
+            return false;
+    }
+    return true;
+}
+
+static void printUsage(const char *program)
+{
+    printf("Usage: %s [options] OUTPUT_DIR\n", program);
+    printf("  --processes N   synthetic processes (default: 100000)\n");
+    printf("  --interfaces N  network interfaces including lo (default: 4)\n");
+    printf("  --cpus N        CPU lines in proc/stat (default: 8)\n");
+    printf("  --tick N        counter position in seconds (default: 0)\n");
+    printf("  --seed N        random seed (default: 1)\n");
+}
+
+int main(int argc, char **argv)
+{
+    FixtureOptions options;
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if (arg == "--processes" && i + 1 < argc)
+            options.processes = max(0, atoi(argv[++i]));
+        else if (arg == "--interfaces" && i + 1 < argc)
+            options.interfaces = max(1, atoi(argv[++i]));
+        else if (arg == "--cpus" && i + 1 < argc)
+            options.cpus = max(1, atoi(argv[++i]));
+        else if (arg == "--tick" && i + 1 < argc)
+            options.tick = max(0L, atol(argv[++i]));
+        else if (arg == "--seed" && i + 1 < argc)
+            options.seed = (unsigned)strtoul(argv[++i], nullptr, 10);
+        else if (arg[0] != '-' && options.root.empty())
+            options.root = arg;
+        else
+        {
+            printUsage(argv[0]);
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+    if (options.root.empty())
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+    while (options.root.size() > 1 && options.root.back() == '/')
+        options.root.pop_back();
+
+    if (!makeDirectories(options.root) || !writeSystemFiles(options) || !writeProcesses(options))
+        return 1;
+
+    printf("Wrote fixture with %d processes to %s (tick %ld)\n", options.processes, options.root.c_str(), options.tick);
+    return 0;
+}
@@ -0,0 +1,157 @@
+/**
+ * @file trace.cpp
+ * @brief Raw source capture for `--record`
+ * @details While recording, every file the collectors read (/proc/stat,
+ *          /proc/meminfo, /proc/net/dev, each /proc/[pid]/stat, the thermal
+ *          and hwmon files, ...) is appended to a trace file exactly as the
+ *          kernel returned it, together with the directory listings used to
+ *          discover PIDs and hwmon devices. Each record carries a monotonic
+ *          timestamp, so a trace can be replayed later with the original
+ *          timing to reproduce an incident or to profile the parsers on real
+ *          input.
+ *
+ *          When recording is off the hooks cost one predictable branch.
+ *
+ * File layout (native byte order):
+ * @code
+ *   [TraceFileHeader]
+ *   [TraceRecordHeader | path bytes | data bytes]
+ *   [TraceRecordHeader | path bytes | data bytes]
+ *   ...
+ * @endcode
+ * @author Stephen Kisengese
+ * @date 2025
+ */
+
+#include "collector.h"
+
+// =============================================================================
+// FILE FORMAT
+// =============================================================================
+
+const char TRACE_MAGIC[8] = {'S', 'Y', 'S', 'M', 'T', 'R', 'C', 'E'};
+
+// =============================================================================
+// RECORDER STATE
+// =============================================================================
+
+static FILE *trace_file = nullptr;  ///< Open trace, nullptr while not recording
+static mutex trace_mutex;           ///< Serializes records from the scan workers
+static vector<char> trace_buffer;   ///< stdio buffer for trace_file
+static uint64_t trace_bytes = 0;    ///< Bytes written so far, for the status line
+
+static uint64_t monotonicNanoseconds()
+{
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Appends one record; safe to call from any thread
+ */
+static void writeRecord(TraceRecordKind kind, const char *path, const char *data, size_t len)
+{
+    TraceRecordHeader header = {};
+    header.data_len = (uint32_t)len;
+    header.path_len = (uint16_t)strnlen(path, UINT16_MAX);
+    header.kind = kind;
+
+    lock_guard<mutex> lock(trace_mutex);
+    if (trace_file == nullptr)
+        return;
+    header.time_ns = monotonicNanoseconds(); // under the lock, so records are in time order
+    fwrite(&header, sizeof(header), 1, trace_file);
+    fwrite(path, 1, header.path_len, trace_file);
+    if (len > 0)
+        fwrite(data, 1, len, trace_file);
+    trace_bytes += sizeof(header) + header.path_len + len;
+}
+
+// =============================================================================
+// PUBLIC INTERFACE
+// =============================================================================
+
+/**
+ * @brief Creates @p path and starts recording every source read
+ * @return false if the file cannot be created
+ * @note Call before startSampler(); the collectors check the recorder
+ *       without synchronization.
+ */
+bool openTraceRecorder(const string &path)
+{
+    closeTraceRecorder();
+
+    FILE *file = fopen(path.c_str(), "wbe");
+    if (file == nullptr)
+        return false;
+
+    trace_buffer.resize(1 << 20);
+    setvbuf(file, trace_buffer.data(), _IOFBF, trace_buffer.size());
+
+    TraceFileHeader header = {};
+    memcpy(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    header.version = TRACE_VERSION;
+    header.record_header_size = sizeof(TraceRecordHeader);
+    header.start_time_ns = monotonicNanoseconds();
+    fwrite(&header, sizeof(header), 1, file);
+
+    lock_guard<mutex> lock(trace_mutex);
+    trace_file = file;
+    trace_bytes = sizeof(header);
+    return true;
+}
+
+/**
+ * @brief Flushes and closes the trace; call after stopSampler()
+ */
+void closeTraceRecorder()
+{
+    lock_guard<mutex> lock(trace_mutex);
+    if (trace_file == nullptr)
+        return;
+
+    fclose(trace_file);
+    trace_file = nullptr;
+    trace_buffer.clear();
+    trace_buffer.shrink_to_fit();
+}
+
+bool traceRecorderActive()
+{
+    return trace_file != nullptr;
+}
+
+uint64_t traceRecorderBytes()
+{
+    lock_guard<mutex> lock(trace_mutex);
+    return trace_bytes;
+}
+
+/**
+ * @brief Records the contents of @p path as it was just read
+ */
+void recordSourceRead(const char *path, const char *data, size_t len)
+{
+    if (trace_file != nullptr)
+        writeRecord(TRACE_FILE, path, data, len);
+}
+
+/**
+ * @brief Records that @p path could not be opened or read
+ * @details Kept so a replay fails the same reads (e.g. a process that exited
+ *          between listing /proc and reading its stat file).
+ */
+void recordSourceMissing(const char *path)
+{
+    if (trace_file != nullptr)
+        writeRecord(TRACE_MISSING, path, nullptr, 0);
+}
+
+/**
+ * @brief Records the entry names of directory @p path
+ * @param names Entry names, each terminated by a NUL byte
+ */
+void recordSourceListing(const char *path, const string &names)
+{
+    if (trace_file != nullptr)
+        writeRecord(TRACE_DIRECTORY, path, names.data(), names.size());
+}
@@ -0,0 +1,73 @@
+/**
+ * @file triple_buffer.h
+ * @brief Lock-free single-producer/single-consumer publication of snapshots
+ * @details Three slots rotate between the producer (the sampler thread), the
+ *          consumer (the render thread) and a shared "latest" slot. Handing a
+ *          slot over is a single atomic exchange, so neither side ever waits
+ *          for the other: a collector stuck in a slow /proc read cannot stall
+ *          a frame, and a slow frame cannot stall a collector.
+ *
+ *          Usage:
+ *          - Producer: fill writeBuffer() completely, then publish(). The
+ *            slot returned by writeBuffer() after a publish holds stale data
+ *            from an older snapshot, so it must be overwritten, not appended to.
+ *          - Consumer: read() returns the newest published value. The
+ *            reference stays valid until the consumer's next read().
+ *
+ *          Exactly one thread may produce and exactly one may consume.
+ * @author Stephen Kisengese
+ * @date 2025
+ */
+
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <atomic>
+#include <cstdint>
+
+template <typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+    TripleBuffer(const TripleBuffer &) = delete;
+    TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+    /**
+     * @brief Slot owned by the producer; fill it before calling publish()
+     */
+    T &writeBuffer() { return slots[write_index]; }
+
+    /**
+     * @brief Makes the producer's slot the latest value and takes a free one
+     */
+    void publish()
+    {
+        uint8_t previous = latest.exchange(write_index | FRESH, std::memory_order_acq_rel);
+        write_index = previous & INDEX_MASK;
+    }
+
+    /**
+     * @brief Returns the newest published value (consumer thread only)
+     */
+    const T &read()
+    {
+        if (latest.load(std::memory_order_relaxed) & FRESH)
+        {
+            uint8_t previous = latest.exchange(read_index, std::memory_order_acq_rel);
+            read_index = previous & INDEX_MASK;
+        }
+        return slots[read_index];
+    }
+
+private:
+    static const uint8_t INDEX_MASK = 0x3;
+    static const uint8_t FRESH = 0x4; // latest slot has not been read yet
+
+    T slots[3] = {};
+    alignas(64) std::atomic<uint8_t> latest{1}; // index of the shared slot, plus FRESH
+    alignas(64) uint8_t write_index = 0;        // producer side only
+    alignas(64) uint8_t read_index = 2;         // consumer side only
+};
+
+#endif // TRIPLE_BUFFER_H
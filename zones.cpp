@@ -0,0 +1,235 @@
+/**
+ * @file zones.cpp
+ * @brief Scoped trace zones recorded per thread and dumped as Chrome trace JSON
+ * @details TRACE_ZONE("name") (collector.h) times the enclosing scope. Every
+ *          thread that records a zone gets its own fixed ring of the last
+ *          ZONE_BUFFER_EVENTS zones, written only by that thread with a
+ *          single release store per zone and no locks, so zones stay on all
+ *          the time and a dump always holds the seconds before a hitch.
+ *
+ *          dumpZoneTrace() copies every ring and writes the Chrome trace event
+ *          format, which chrome://tracing, Perfetto (ui.perfetto.dev) and
+ *          speedscope open directly. Copying never blocks the writers: events
+ *          a writer may have overwritten during the copy are dropped.
+ *
+ *          Zone names must be string literals (or otherwise live for the whole
+ *          run); only the pointer is stored.
+ * @author Stephen Kisengese
+ * @date 2025
+ */
+
+#include "collector.h"
+#include <sys/syscall.h>
+
+// =============================================================================
+// PER-THREAD BUFFERS
+// =============================================================================
+
+// Zones kept per thread; a power of two. 8192 zones is several minutes of
+// sampler and render activity at the default rates.
+#define ZONE_BUFFER_EVENTS 8192
+// Threads besides the scan workers that can record zones (render or main,
+// sampler, proc events, metrics server, and spares for benchmarks). Every
+// scan worker gets a buffer too; threads past the limit record nothing and
+// are counted in zone_threads_dropped.
+#define ZONE_FIXED_THREADS 8
+
+/**
+ * @brief One completed zone
+ */
+struct ZoneEvent
+{
+    const char *name;
+    uint64_t start_ns; ///< zoneClockNs() at scope entry
+    uint64_t end_ns;   ///< zoneClockNs() at scope exit
+};
+
+/**
+ * @brief Ring of the most recent zones of one thread
+ * @details Only the owning thread writes events and advances @c written;
+ *          readers load @c written with acquire ordering before and after
+ *          copying to find out which slots were stable.
+ */
+struct ZoneBuffer
+{
+    ZoneEvent events[ZONE_BUFFER_EVENTS];
+    atomic<uint64_t> written{0}; ///< Zones recorded since the thread started
+    atomic<const char *> name{nullptr};
+    int tid = 0;
+};
+
+static mutex zone_buffers_mutex;                  ///< Protects zone_buffers (registration and dumps)
+static vector<unique_ptr<ZoneBuffer>> zone_buffers; ///< Every registered thread; kept after the thread exits
+static atomic<int> zone_threads_dropped(0);         ///< Threads that found the table full
+static thread_local ZoneBuffer *local_zone_buffer = nullptr;
+static thread_local bool zone_buffer_failed = false;
+
+/**
+ * @brief Returns the calling thread's buffer, registering it on first use
+ * @return nullptr once ZONE_FIXED_THREADS plus one per scan worker have registered
+ */
+static ZoneBuffer *threadZoneBuffer()
+{
+    if (local_zone_buffer != nullptr || zone_buffer_failed)
+        return local_zone_buffer;
+
+    lock_guard<mutex> lock(zone_buffers_mutex);
+    if (zone_buffers.size() >= ZONE_FIXED_THREADS + (size_t)process_scan_workers)
+    {
+        zone_buffer_failed = true;
+        zone_threads_dropped.fetch_add(1, memory_order_relaxed);
+        return nullptr;
+    }
+    zone_buffers.push_back(make_unique<ZoneBuffer>());
+    local_zone_buffer = zone_buffers.back().get();
+    local_zone_buffer->tid = (int)syscall(SYS_gettid);
+    return local_zone_buffer;
+}
+
+/**
+ * @brief Monotonic clock used for zone timestamps, in nanoseconds
+ */
+uint64_t zoneClockNs()
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * @brief Names the calling thread in dumped traces
+ * @param name String literal, e.g. "sampler"
+ */
+void nameZoneThread(const char *name)
+{
+    ZoneBuffer *buffer = threadZoneBuffer();
+    if (buffer != nullptr)
+        buffer->name.store(name, memory_order_release);
+}
+
+/**
+ * @brief Appends one completed zone to the calling thread's ring
+ */
+void recordZone(const char *name, uint64_t start_ns, uint64_t end_ns)
+{
+    ZoneBuffer *buffer = threadZoneBuffer();
+    if (buffer == nullptr)
+        return;
+
+    uint64_t index = buffer->written.load(memory_order_relaxed);
+    ZoneEvent &event = buffer->events[index & (ZONE_BUFFER_EVENTS - 1)];
+    event.name = name;
+    event.start_ns = start_ns;
+    event.end_ns = end_ns;
+    buffer->written.store(index + 1, memory_order_release);
+}
+
+/**
+ * @brief Threads whose zones are not recorded because the buffer table was full
+ */
+int droppedZoneThreads()
+{
+    return zone_threads_dropped.load(memory_order_relaxed);
+}
+
+// =============================================================================
+// CHROME TRACE EXPORT
+// =============================================================================
+
+/**
+ * @brief Copies the zones of @p buffer that were not overwritten during the copy
+ */
+static void copyZones(const ZoneBuffer &buffer, vector<ZoneEvent> &out)
+{
+    uint64_t end = buffer.written.load(memory_order_acquire);
+    uint64_t begin = end > ZONE_BUFFER_EVENTS ? end - ZONE_BUFFER_EVENTS : 0;
+
+    out.clear();
+    for (uint64_t i = begin; i < end; i++)
+        out.push_back(buffer.events[i & (ZONE_BUFFER_EVENTS - 1)]);
+
+    // Slots at or below written - ZONE_BUFFER_EVENTS may have been reused
+    // (the one at written itself may be half written)
+    atomic_thread_fence(memory_order_acquire);
+    uint64_t now = buffer.written.load(memory_order_relaxed);
+    uint64_t stable = now >= ZONE_BUFFER_EVENTS ? now - ZONE_BUFFER_EVENTS + 1 : 0;
+    if (stable > begin)
+        out.erase(out.begin(), out.begin() + (ptrdiff_t)min<uint64_t>(stable - begin, out.size()));
+}
+
+static void writeJsonString(FILE *out, const char *text)
+{
+    fputc('"', out);
+    for (const char *p = text; *p != '\0'; p++)
+    {
+        if (*p == '"' || *p == '\\')
+            fputc('\\', out);
+        if ((unsigned char)*p >= 0x20)
+            fputc(*p, out);
+    }
+    fputc('"', out);
+}
+
+/**
+ * @brief Writes every thread's recorded zones to @p path as Chrome trace JSON
+ * @return false on an I/O error (errno is set)
+ * @note Callable from any thread; recording continues during the dump.
+ */
+bool dumpZoneTrace(const string &path)
+{
+    FILE *out = fopen(path.c_str(), "we");
+    if (out == nullptr)
+        return false;
+
+    int pid = getpid();
+    fprintf(out, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    fprintf(out, "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":%d,\"tid\":0,\"args\":{\"name\":\"monitor\"}}", pid);
+
+    vector<ZoneEvent> events;
+    lock_guard<mutex> lock(zone_buffers_mutex);
+    for (const unique_ptr<ZoneBuffer> &buffer : zone_buffers)
+    {
+        const char *name = buffer->name.load(memory_order_acquire);
+        char fallback[32];
+        if (name == nullptr)
+        {
+            snprintf(fallback, sizeof(fallback), "thread %d", buffer->tid);
+            name = fallback;
+        }
+        fprintf(out, ",\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":", pid,
+                buffer->tid);
+        writeJsonString(out, name);
+        fprintf(out, "}}");
+
+        // Complete ("X") events; timestamps in microseconds
+        copyZones(*buffer, events);
+        for (const ZoneEvent &event : events)
+        {
+            fprintf(out, ",\n{\"ph\":\"X\",\"name\":");
+            writeJsonString(out, event.name);
+            fprintf(out, ",\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}", pid, buffer->tid,
+                    event.start_ns / 1000.0, (event.end_ns - event.start_ns) / 1000.0);
+        }
+    }
+    // Threads without a buffer are missing from the timeline; say so
+    fprintf(out, "\n],\"otherData\":{\"dropped_threads\":%d}}\n", droppedZoneThreads());
+
+    bool ok = !ferror(out);
+    if (fclose(out) != 0)
+        ok = false;
+    return ok;
+}
+
+/**
+ * @brief Dumps the zones to monitor-zones-<unix ms>.json in the working directory
+ * @param path Receives the file name
+ * @return false on an I/O error (errno is set)
+ */
+bool dumpZoneTraceNow(string &path)
+{
+    long long now_ms = chrono::duration_cast<chrono::milliseconds>(
+                           chrono::system_clock::now().time_since_epoch())
+                           .count();
+    path = "monitor-zones-" + to_string(now_ms) + ".json";
+    return dumpZoneTrace(path);
+}